@@ -0,0 +1,125 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file archetype_benchmarks.cpp
+ * @date 2026-10-17
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "ecs/archetype_storage.hpp"
+#include "ecs/entity_view.hpp"
+#include "scene/components.hpp"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+
+using namespace gwars;
+
+/* Projectiles as the game creates them, minus the game's own tag and polygon components, stored either in
+ * EntityManager's sparse sets or in ArchetypeStorage's chunks */
+constexpr float PHYSICS_DT = 1.0f / 60.0f;
+
+static TransformComponent makeProjectileTransform(size_t i)
+{
+    return TransformComponent(Vec2f(static_cast<float>(i % 1000), static_cast<float>(i / 1000)));
+}
+
+static void integrate(PhysicsComponent& physicsComponent, TransformComponent& transform)
+{
+    physicsComponent.velocity += physicsComponent.force / physicsComponent.mass * PHYSICS_DT;
+    transform.translation += physicsComponent.velocity * PHYSICS_DT;
+}
+
+static void updateBoundingSphere(const TransformComponent& transform,
+                                 WorldTransformComponent&  worldTransform,
+                                 BoundingSphereComponent&  boundingSphereComponent)
+{
+    worldTransform.matrix = transform.calculateMatrix();
+
+    boundingSphereComponent.wsTranslation = Vec2f(worldTransform.matrix
+                                                  * Vec3f(boundingSphereComponent.msTranslation, 1));
+
+    Vec2f scale                      = worldTransform.getScale();
+    boundingSphereComponent.wsRadius = boundingSphereComponent.msRadius * std::max(scale.x, scale.y);
+}
+
+static void BM_ProjectilesSparseSets(benchmark::State& state)
+{
+    EntityManager entities;
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        EntityId id = entities.createEntity();
+        entities.createComponent<TransformComponent>(id, makeProjectileTransform(i));
+        entities.createComponent<WorldTransformComponent>(id);
+        entities.createComponent<PhysicsComponent>(id, Vec2f(0, 750));
+        entities.createComponent<BoundingSphereComponent>(id, 0.3f);
+    }
+
+    for (auto _ : state)
+    {
+        for (auto [entity, physicsComponent, transform] : getView<PhysicsComponent, TransformComponent>(entities))
+        {
+            integrate(physicsComponent, transform);
+        }
+
+        for (auto [entity, transform, worldTransform, boundingSphereComponent] :
+             getView<const TransformComponent, WorldTransformComponent, BoundingSphereComponent>(entities))
+        {
+            updateBoundingSphere(transform, worldTransform, boundingSphereComponent);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_ProjectilesArchetypes(benchmark::State& state)
+{
+    ArchetypeStorage storage;
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        storage.createEntity(makeProjectileTransform(i),
+                             WorldTransformComponent(),
+                             PhysicsComponent(Vec2f(0, 750)),
+                             BoundingSphereComponent(0.3f));
+    }
+
+    for (auto _ : state)
+    {
+        storage.forEach<PhysicsComponent, TransformComponent>(
+            [](EntityId, PhysicsComponent& physicsComponent, TransformComponent& transform) {
+                integrate(physicsComponent, transform);
+            });
+
+        storage.forEach<TransformComponent, WorldTransformComponent, BoundingSphereComponent>(
+            [](EntityId,
+               TransformComponent&      transform,
+               WorldTransformComponent& worldTransform,
+               BoundingSphereComponent& boundingSphereComponent) {
+                updateBoundingSphere(transform, worldTransform, boundingSphereComponent);
+            });
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_ProjectilesSparseSets)->Arg(1000)->Arg(10000)->Arg(100000);
+BENCHMARK(BM_ProjectilesArchetypes)->Arg(1000)->Arg(10000)->Arg(100000);
@@ -0,0 +1,204 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file event_benchmarks.cpp
+ * @date 2026-10-17
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "events/event_dispatcher.hpp"
+#include "input/mouse.hpp"
+#include <benchmark/benchmark.h>
+#include <functional>
+#include <memory>
+#include <typeindex>
+#include <unordered_map>
+
+using namespace gwars;
+
+struct MouseMoveHandler
+{
+    float sum{0};
+
+    void onMouseMove(const MouseMoveEvent& event) { sum += event.x; }
+};
+
+static float g_FunctionSum = 0;
+
+static void onMouseMove(const MouseMoveEvent& event) { g_FunctionSum += event.y; }
+
+//==================================================================================================
+// Handlers
+//==================================================================================================
+/* Handlers as stored before Delegate, std::function copied for every call */
+static void BM_StdFunctionHandlers(benchmark::State& state)
+{
+    using Handler = std::function<void(const MouseMoveEvent&)>;
+
+    std::vector<MouseMoveHandler> objects(state.range(0));
+    std::vector<Handler>          handlers;
+    for (size_t i = 0; i < objects.size(); ++i)
+    {
+        if (i % 2 == 0)
+        {
+            handlers.emplace_back(std::bind(&MouseMoveHandler::onMouseMove, &objects[i], std::placeholders::_1));
+        }
+        else
+        {
+            handlers.emplace_back(&onMouseMove);
+        }
+    }
+
+    MouseMoveEvent event(1, 2);
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < handlers.size(); ++i)
+        {
+            Handler handler = handlers[i];
+            handler(event);
+        }
+
+        benchmark::DoNotOptimize(objects.data());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_DelegateHandlers(benchmark::State& state)
+{
+    std::vector<MouseMoveHandler> objects(state.range(0));
+    EventSink<MouseMoveEvent>     sink;
+    for (size_t i = 0; i < objects.size(); ++i)
+    {
+        if (i % 2 == 0)
+        {
+            sink.addHandler<&MouseMoveHandler::onMouseMove>(objects[i]);
+        }
+        else
+        {
+            sink.addHandler<&onMouseMove>();
+        }
+    }
+
+    MouseMoveEvent event(1, 2);
+    for (auto _ : state)
+    {
+        sink.fireEvent(event);
+        benchmark::DoNotOptimize(objects.data());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_StdFunctionHandlers)->Arg(2)->Arg(5)->Arg(17);
+BENCHMARK(BM_DelegateHandlers)->Arg(2)->Arg(5)->Arg(17);
+
+//==================================================================================================
+// Dispatcher
+//==================================================================================================
+template<int N>
+struct FillerEvent
+{
+};
+
+template<int... Ns>
+static void createFillerSinks(EventDispatcher& dispatcher, std::integer_sequence<int, Ns...>)
+{
+    (dispatcher.getSink<FillerEvent<Ns>>(), ...);
+}
+
+/* Sinks as stored before the flat array, looked up by type_index and downcast with dynamic_cast */
+class TypeMapDispatcher
+{
+public:
+    template<typename T>
+    EventSink<T>& getSink()
+    {
+        std::unique_ptr<IEventSink>& sink = m_Sinks[std::type_index(typeid(T))];
+        if (sink == nullptr)
+        {
+            sink = std::make_unique<EventSink<T>>();
+        }
+
+        return *dynamic_cast<EventSink<T>*>(sink.get());
+    }
+
+    template<typename T, typename... Args>
+    void fireEvent(Args&&... args)
+    {
+        T event(std::forward<Args>(args)...);
+        getSink<T>().fireEvent(event);
+    }
+
+private:
+    std::unordered_map<std::type_index, std::unique_ptr<IEventSink>> m_Sinks;
+};
+
+template<int... Ns>
+static void createFillerSinks(TypeMapDispatcher& dispatcher, std::integer_sequence<int, Ns...>)
+{
+    (dispatcher.getSink<FillerEvent<Ns>>(), ...);
+}
+
+template<typename DispatcherT>
+static void BM_DispatcherFireEvent(benchmark::State& state)
+{
+    DispatcherT dispatcher;
+    createFillerSinks(dispatcher, std::make_integer_sequence<int, 16>());
+
+    MouseMoveHandler handler;
+    dispatcher.template getSink<MouseMoveEvent>().template addHandler<&MouseMoveHandler::onMouseMove>(handler);
+
+    for (auto _ : state)
+    {
+        dispatcher.template fireEvent<MouseMoveEvent>(1.0f, 2.0f);
+        benchmark::DoNotOptimize(handler.sum);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_DispatcherFireEvent, TypeMapDispatcher);
+BENCHMARK_TEMPLATE(BM_DispatcherFireEvent, EventDispatcher);
+
+static void BM_DispatcherQueuedEvents(benchmark::State& state)
+{
+    EventDispatcher  dispatcher;
+    MouseMoveHandler handler;
+    dispatcher.getSink<MouseMoveEvent>().addHandler<&MouseMoveHandler::onMouseMove>(handler);
+
+    for (auto _ : state)
+    {
+        for (int64_t i = 0; i < state.range(0); ++i)
+        {
+            dispatcher.enqueueEvent<MouseMoveEvent>(1.0f, 2.0f);
+        }
+
+        dispatcher.dispatchQueued();
+        benchmark::DoNotOptimize(handler.sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_DispatcherQueuedEvents)->Arg(1000);
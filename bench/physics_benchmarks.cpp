@@ -0,0 +1,201 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file physics_benchmarks.cpp
+ * @date 2026-10-17
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "scene/rigid_body_storage.hpp"
+#include "scene/systems.hpp"
+#include <benchmark/benchmark.h>
+
+using namespace gwars;
+
+constexpr float PHYSICS_DT = 1.0f / 60.0f;
+
+static void createBodies(Scene& scene, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        Entity entity = scene.createEntity();
+        entity.createComponent<TransformComponent>(Vec2f(static_cast<float>(i % 1000), static_cast<float>(i / 1000)));
+        entity.createComponent<PhysicsComponent>(Vec2f(1, -1));
+
+        PhysicsComponent& physicsComponent = entity.getComponent<PhysicsComponent>();
+        physicsComponent.force             = Vec2f(0.5f, static_cast<float>(i % 7));
+        physicsComponent.mass              = 1.0f + static_cast<float>(i % 3);
+    }
+}
+
+/* The loop PhysicsSystem had originally, which marks every body changed */
+static void BM_PhysicsAoS(benchmark::State& state)
+{
+    EventDispatcher eventDispatcher;
+    Scene           scene(eventDispatcher);
+    createBodies(scene, state.range(0));
+
+    Query<Exclude<>, PhysicsComponent, TransformComponent> bodies(scene.getEntityManager());
+
+    for (auto _ : state)
+    {
+        for (auto [entity, physicsComponent, transform] : bodies)
+        {
+            Vec2f acceleration = physicsComponent.force / physicsComponent.mass;
+            physicsComponent.velocity += acceleration * PHYSICS_DT;
+
+            transform.translation += physicsComponent.velocity * PHYSICS_DT;
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/* Bodies copied into structure of arrays streams for a vectorized kernel and the changed ones copied back, as
+ * PhysicsSystem did for a while. The kernel itself is vectorized, but the copies cost more than it saves. */
+static void BM_PhysicsStagedSoA(benchmark::State& state)
+{
+    EventDispatcher eventDispatcher;
+    Scene           scene(eventDispatcher);
+    createBodies(scene, state.range(0));
+
+    Query<Exclude<>, const PhysicsComponent, const TransformComponent> bodies(scene.getEntityManager());
+    ComponentPool<PhysicsComponent>&   physicsComponents = scene.getEntityManager().getPool<PhysicsComponent>();
+    ComponentPool<TransformComponent>& transforms        = scene.getEntityManager().getPool<TransformComponent>();
+
+    std::vector<float> x, y, vx, vy, fx, fy, mass;
+
+    for (auto _ : state)
+    {
+        const size_t count = bodies.size();
+        for (std::vector<float>* stream : {&x, &y, &vx, &vy, &fx, &fy, &mass})
+        {
+            stream->resize(count);
+        }
+
+        size_t i = 0;
+        for (auto [entity, physicsComponent, transform] : bodies)
+        {
+            x[i]    = transform.translation.x;
+            y[i]    = transform.translation.y;
+            vx[i]   = physicsComponent.velocity.x;
+            vy[i]   = physicsComponent.velocity.y;
+            fx[i]   = physicsComponent.force.x;
+            fy[i]   = physicsComponent.force.y;
+            mass[i] = physicsComponent.mass;
+            ++i;
+        }
+
+        float* __restrict__ xs  = x.data();
+        float* __restrict__ ys  = y.data();
+        float* __restrict__ vxs = vx.data();
+        float* __restrict__ vys = vy.data();
+        for (i = 0; i < count; ++i)
+        {
+            vxs[i] += fx[i] / mass[i] * PHYSICS_DT;
+            vys[i] += fy[i] / mass[i] * PHYSICS_DT;
+            xs[i] += vxs[i] * PHYSICS_DT;
+            ys[i] += vys[i] * PHYSICS_DT;
+        }
+
+        i = 0;
+        for (auto [entity, physicsComponent, transform] : bodies)
+        {
+            if (x[i] != transform.translation.x || y[i] != transform.translation.y)
+            {
+                transforms.modify(entity.getId()).translation = Vec2f(x[i], y[i]);
+            }
+
+            if (vx[i] != physicsComponent.velocity.x || vy[i] != physicsComponent.velocity.y)
+            {
+                physicsComponents.modify(entity.getId()).velocity = Vec2f(vx[i], vy[i]);
+            }
+
+            ++i;
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_PhysicsSystem(benchmark::State& state)
+{
+    EventDispatcher eventDispatcher;
+    Scene           scene(eventDispatcher);
+    createBodies(scene, state.range(0));
+
+    PhysicsSystem system(scene);
+
+    for (auto _ : state)
+    {
+        system.onUpdate(PHYSICS_DT);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void createRigidBodies(RigidBodyStorage& storage, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        EntityId id = makeEntityId(static_cast<uint32_t>(i + 1), 1);
+        storage.addBody(id, Vec2f(static_cast<float>(i % 1000), static_cast<float>(i / 1000)), Vec2f(1, -1),
+                        1.0f + static_cast<float>(i % 3));
+        storage.setForce(id, Vec2f(0.5f, static_cast<float>(i % 7)));
+    }
+}
+
+/* Same bodies, but stored in RigidBodyStorage's persistent columns, so nothing is copied */
+static void BM_RigidBodyStorageScalar(benchmark::State& state)
+{
+    RigidBodyStorage storage;
+    createRigidBodies(storage, state.range(0));
+
+    for (auto _ : state)
+    {
+        storage.integrateScalar(PHYSICS_DT);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_RigidBodyStorage(benchmark::State& state)
+{
+    RigidBodyStorage storage;
+    createRigidBodies(storage, state.range(0));
+
+    for (auto _ : state)
+    {
+        storage.integrate(PHYSICS_DT);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_PhysicsAoS)->Arg(1000)->Arg(10000)->Arg(100000);
+BENCHMARK(BM_PhysicsStagedSoA)->Arg(1000)->Arg(10000)->Arg(100000);
+BENCHMARK(BM_PhysicsSystem)->Arg(1000)->Arg(10000)->Arg(100000);
+BENCHMARK(BM_RigidBodyStorageScalar)->Arg(1000)->Arg(10000)->Arg(100000);
+BENCHMARK(BM_RigidBodyStorage)->Arg(1000)->Arg(10000)->Arg(100000);
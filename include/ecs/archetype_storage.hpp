@@ -0,0 +1,236 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file archetype_storage.hpp
+ * @date 2026-10-16
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include "ecs/component_signature.hpp"
+#include "ecs/component_type.hpp"
+#include "ecs/entity_id.hpp"
+#include <stddef.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace gwars {
+
+/**
+ * @brief Type-erased description of a component column, used to move and destroy components
+ *        without knowing their type.
+ */
+struct ComponentColumnInfo
+{
+    ComponentTypeId typeId{INVALID_COMPONENT_ID};
+    size_t          size{0};
+    size_t          alignment{0};
+
+    void (*moveConstruct)(void* destination, void* source){nullptr};
+    void (*destroy)(void* component){nullptr};
+
+    template<typename T>
+    static ComponentColumnInfo create();
+};
+
+/**
+ * @brief Set of entities that have exactly the same components.
+ *
+ * Entities are stored in fixed-size chunks. Each chunk is split into columns, one per component type
+ * plus one for entity ids, so that iterating over a component streams through contiguous memory.
+ * Rows are kept dense: removal moves the archetype's last row into the freed one. Chunks left empty by
+ * removals are freed, except for a single spare one, so that an archetype oscillating around a chunk
+ * boundary doesn't allocate on every other row.
+ *
+ * Each archetype caches the archetypes reached by adding or removing a single component (its edges), so
+ * structural changes that have happened once before don't need to look up the destination archetype.
+ */
+class Archetype
+{
+public:
+    static constexpr size_t CHUNK_SIZE      = 16 * 1024;
+    static constexpr size_t CHUNK_ALIGNMENT = 64;
+
+    Archetype(std::vector<ComponentColumnInfo> columns);
+    ~Archetype();
+
+    Archetype(const Archetype& other)            = delete;
+    Archetype& operator=(const Archetype& other) = delete;
+
+    const std::vector<ComponentColumnInfo>& getColumns() const;
+    const ComponentSignature&               getSignature() const;
+
+    /**
+     * @return Column index of the component type or -1 if the archetype doesn't have it.
+     */
+    int32_t findColumn(ComponentTypeId typeId) const;
+
+    /**
+     * @brief Reserves a new row for the entity, component memory of the row is left uninitialized.
+     * @return Global row index in the archetype.
+     */
+    uint32_t allocateRow(EntityId id);
+
+    /**
+     * @brief Destroys row's components and fills the hole with the last row.
+     * @return Id of the entity moved into the row or INVALID_ENTITY_ID if no entity was moved.
+     */
+    EntityId removeRow(uint32_t row);
+
+    /**
+     * @brief Same as removeRow, but doesn't destroy the components (they must have been moved out).
+     */
+    EntityId releaseRow(uint32_t row);
+
+    /**
+     * @brief Destroys all rows and frees all chunks.
+     */
+    void clear();
+
+    /**
+     * @return Archetype with the component type added or removed, nullptr if the edge isn't cached yet.
+     */
+    Archetype* getAddEdge(ComponentTypeId typeId) const;
+    Archetype* getRemoveEdge(ComponentTypeId typeId) const;
+
+    void setAddEdge(ComponentTypeId typeId, Archetype* archetype);
+    void setRemoveEdge(ComponentTypeId typeId, Archetype* archetype);
+
+    void* getComponent(uint32_t row, size_t column);
+    void* getColumn(size_t chunk, size_t column);
+
+    EntityId        getEntity(uint32_t row) const;
+    const EntityId* getEntities(size_t chunk) const;
+
+    size_t   getChunksCount() const;
+    uint32_t getChunkSize(size_t chunk) const;
+    uint32_t getChunkCapacity() const;
+    uint32_t size() const;
+
+    /**
+     * @return Number of chunks in memory, including the spare one.
+     */
+    size_t getAllocatedChunksCount() const;
+
+private:
+    EntityId fillHole(uint32_t row);
+    void     freeChunks(size_t keptCount);
+
+private:
+    std::vector<ComponentColumnInfo> m_Columns;
+    ComponentSignature               m_Signature;
+    Archetype*                       m_AddEdges[MAX_COMPONENT_TYPES]{};
+    Archetype*                       m_RemoveEdges[MAX_COMPONENT_TYPES]{};
+    std::vector<size_t>              m_ColumnOffsets;
+    size_t                           m_EntitiesOffset{0};
+    uint32_t                         m_ChunkCapacity{0};
+    uint32_t                         m_Size{0};
+    size_t                           m_ChunkBytes{0};
+    std::vector<uint8_t*>            m_Chunks;
+};
+
+/**
+ * @brief Alternative to EntityManager, which groups entities by their component signature (archetype).
+ *
+ * Queries iterate over matching archetypes chunk by chunk with no per-entity lookups, so it suits
+ * large amounts of homogeneous entities (projectiles, enemies). Adding or removing a component moves
+ * the entity to another archetype, which makes structural changes more expensive than in EntityManager.
+ * Archetypes are keyed by their ComponentSignature and linked by edges, so once an archetype graph is
+ * built, structural changes don't allocate or sort.
+ */
+class ArchetypeStorage
+{
+public:
+    ArchetypeStorage() = default;
+    ~ArchetypeStorage();
+
+    ArchetypeStorage(const ArchetypeStorage& other)            = delete;
+    ArchetypeStorage& operator=(const ArchetypeStorage& other) = delete;
+
+    template<typename... Ts>
+    EntityId createEntity(Ts&&... components);
+
+    void removeEntity(EntityId id);
+    bool isAlive(EntityId id) const;
+    void clear();
+
+    template<typename T, typename... Args>
+    void createComponent(EntityId id, Args&&... args);
+
+    template<typename T>
+    void removeComponent(EntityId id);
+
+    template<typename T>
+    T& getComponent(EntityId id);
+
+    template<typename T>
+    bool hasComponent(EntityId id) const;
+
+    /**
+     * @brief Calls function(EntityId, Ts&...) for every entity that has all of the components Ts.
+     */
+    template<typename... Ts, typename Function>
+    void forEach(Function&& function);
+
+    size_t size() const;
+    size_t getArchetypesCount() const;
+
+private:
+    struct EntityLocation
+    {
+        EntityId   id{INVALID_ENTITY_ID};
+        Archetype* archetype{nullptr};
+        uint32_t   row{0};
+    };
+
+    struct SignatureHash
+    {
+        size_t operator()(const ComponentSignature& signature) const { return signature.hash(); }
+    };
+
+    EntityId   allocateEntity();
+    void       releaseIndex(uint32_t index);
+    Archetype* getArchetype(const ComponentSignature& signature, std::vector<ComponentColumnInfo> columns);
+    Archetype* getAddTransition(Archetype* source, const ComponentColumnInfo& column);
+    Archetype* getRemoveTransition(Archetype* source, ComponentTypeId typeId);
+    void       moveEntity(EntityId id, Archetype* destination);
+    void       onRowMoved(EntityId movedEntity, uint32_t row);
+
+    template<typename... Ts>
+    Archetype* getArchetype();
+
+    template<typename... Ts, typename Function, size_t... Indices>
+    void forEachInArchetype(Archetype& archetype, Function& function, std::index_sequence<Indices...>);
+
+private:
+    std::vector<Archetype*>                                          m_Archetypes;
+    std::unordered_map<ComponentSignature, Archetype*, SignatureHash> m_ArchetypesBySignature;
+    std::vector<EntityLocation>                                      m_Locations;
+    std::vector<uint32_t>                                            m_FreeIndices;
+    size_t                                                           m_Size{0};
+};
+
+} // namespace gwars
+
+#include "ecs/archetype_storage.ipp"
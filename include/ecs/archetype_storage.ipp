@@ -0,0 +1,161 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file archetype_storage.ipp
+ * @date 2026-10-16
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cassert>
+#include <new>
+#include <tuple>
+#include <type_traits>
+
+namespace gwars {
+
+template<typename T>
+ComponentColumnInfo ComponentColumnInfo::create()
+{
+    static_assert(alignof(T) <= Archetype::CHUNK_ALIGNMENT, "Chunks can't satisfy the component's alignment");
+
+    ComponentColumnInfo info;
+    info.typeId        = ComponentType<T>::getId();
+    info.size          = sizeof(T);
+    info.alignment     = alignof(T);
+    info.moveConstruct = [](void* destination, void* source) {
+        new (destination) T(std::move(*static_cast<T*>(source)));
+    };
+    info.destroy = [](void* component) { static_cast<T*>(component)->~T(); };
+
+    return info;
+}
+
+template<typename... Ts>
+EntityId ArchetypeStorage::createEntity(Ts&&... components)
+{
+    Archetype* archetype = getArchetype<std::decay_t<Ts>...>();
+
+    EntityId id  = allocateEntity();
+    uint32_t row = archetype->allocateRow(id);
+
+    (new (archetype->getComponent(row, archetype->findColumn(ComponentType<std::decay_t<Ts>>::getId())))
+         std::decay_t<Ts>(std::forward<Ts>(components)),
+     ...);
+
+    EntityLocation& location = m_Locations[getEntityIndex(id)];
+    location.archetype       = archetype;
+    location.row             = row;
+
+    return id;
+}
+
+template<typename T, typename... Args>
+void ArchetypeStorage::createComponent(EntityId id, Args&&... args)
+{
+    assert(isAlive(id));
+    assert(!hasComponent<T>(id));
+
+    moveEntity(id, getAddTransition(m_Locations[getEntityIndex(id)].archetype, ComponentColumnInfo::create<T>()));
+
+    EntityLocation& location = m_Locations[getEntityIndex(id)];
+    int32_t         column   = location.archetype->findColumn(ComponentType<T>::getId());
+    new (location.archetype->getComponent(location.row, column)) T(std::forward<Args>(args)...);
+}
+
+template<typename T>
+void ArchetypeStorage::removeComponent(EntityId id)
+{
+    assert(isAlive(id));
+    assert(hasComponent<T>(id));
+
+    moveEntity(id, getRemoveTransition(m_Locations[getEntityIndex(id)].archetype, ComponentType<T>::getId()));
+}
+
+template<typename T>
+T& ArchetypeStorage::getComponent(EntityId id)
+{
+    assert(isAlive(id));
+
+    EntityLocation& location = m_Locations[getEntityIndex(id)];
+    int32_t         column   = location.archetype->findColumn(ComponentType<T>::getId());
+    assert(column >= 0);
+
+    return *static_cast<T*>(location.archetype->getComponent(location.row, column));
+}
+
+template<typename T>
+bool ArchetypeStorage::hasComponent(EntityId id) const
+{
+    assert(isAlive(id));
+    return m_Locations[getEntityIndex(id)].archetype->getSignature().test(ComponentType<T>::getId());
+}
+
+template<typename... Ts, typename Function>
+void ArchetypeStorage::forEach(Function&& function)
+{
+    const ComponentSignature mask = ComponentSignature::create<Ts...>();
+    for (Archetype* archetype : m_Archetypes)
+    {
+        if (archetype->getSignature().contains(mask))
+        {
+            forEachInArchetype<Ts...>(*archetype, function, std::index_sequence_for<Ts...>{});
+        }
+    }
+}
+
+template<typename... Ts>
+Archetype* ArchetypeStorage::getArchetype()
+{
+    const ComponentSignature signature = ComponentSignature::create<Ts...>();
+
+    /* Columns are only built when the archetype doesn't exist yet */
+    auto it = m_ArchetypesBySignature.find(signature);
+    if (it != m_ArchetypesBySignature.end())
+    {
+        return it->second;
+    }
+
+    return getArchetype(signature, {ComponentColumnInfo::create<Ts>()...});
+}
+
+template<typename... Ts, typename Function, size_t... Indices>
+void ArchetypeStorage::forEachInArchetype(Archetype& archetype, Function& function, std::index_sequence<Indices...>)
+{
+    const int32_t columns[] = {archetype.findColumn(ComponentType<Ts>::getId())..., 0};
+
+    for (size_t chunk = 0; chunk < archetype.getChunksCount(); ++chunk)
+    {
+        const EntityId* entities = archetype.getEntities(chunk);
+        const uint32_t  count    = archetype.getChunkSize(chunk);
+
+        std::tuple<Ts*...> componentColumns{static_cast<Ts*>(archetype.getColumn(chunk, columns[Indices]))...};
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            function(entities[i], std::get<Indices>(componentColumns)[i]...);
+        }
+    }
+}
+
+} // namespace gwars
@@ -0,0 +1,138 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file command_buffer.hpp
+ * @date 2026-10-16
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include "ecs/entity_manager.hpp"
+#include "ecs/prefab.hpp"
+#include <stddef.h>
+#include <vector>
+
+namespace gwars {
+
+/**
+ * @brief Records structural changes (entity creation/destruction, adding/removing components) to be
+ *        applied later at a single sync point with flush().
+ *
+ * Recording doesn't touch the EntityManager, so it is safe while views are being iterated. A buffer
+ * must only be used by one thread at a time, parallel systems should use one buffer per thread.
+ * Memory is reused between flushes, so recording doesn't allocate in steady state.
+ */
+class CommandBuffer
+{
+public:
+    CommandBuffer() = default;
+    ~CommandBuffer();
+
+    CommandBuffer(const CommandBuffer& other)            = delete;
+    CommandBuffer& operator=(const CommandBuffer& other) = delete;
+
+    /**
+     * @brief Records entity creation.
+     *
+     * @return Placeholder id, which can be passed to other commands of this buffer until it is flushed.
+     *         It is replaced with the real entity id when the commands are applied. Placeholders use the
+     *         generation, which entities never get, so up to ENTITY_INDEX_MASK + 1 can be created per flush.
+     */
+    EntityId createEntity();
+
+    void destroyEntity(EntityId id);
+
+    template<typename T, typename... Args>
+    void createComponent(EntityId id, Args&&... args);
+
+    template<typename T>
+    void removeComponent(EntityId id);
+
+    /**
+     * @brief Records instantiation of the prefab, see gwars::instantiate().
+     *
+     * @warning The prefab is referenced, not copied, so it must outlive the flush.
+     */
+    template<typename Initializer>
+    void instantiate(const Prefab& prefab, size_t count, Initializer&& initializer);
+
+    /**
+     * @brief Applies recorded commands in the order they were recorded and clears the buffer.
+     *
+     * Commands targeting entities, which don't exist by the time they are applied, are skipped.
+     * Commands recorded while flushing (e.g. by construct event handlers) are applied as well.
+     */
+    void flush(EntityManager& manager);
+
+    bool empty() const;
+
+    static bool isPlaceholder(EntityId id);
+
+private:
+    enum class CommandType
+    {
+        CreateEntity,
+        DestroyEntity,
+        CreateComponent,
+        RemoveComponent,
+        Instantiate
+    };
+
+    using ApplyFunction   = void (*)(EntityManager& manager, EntityId id, void* payload);
+    using DestroyFunction = void (*)(void* payload);
+
+    struct Command
+    {
+        CommandType     type;
+        EntityId        entity{INVALID_ENTITY_ID};
+        void*           payload{nullptr};
+        ApplyFunction   apply{nullptr};
+        DestroyFunction destroy{nullptr};
+    };
+
+    struct Block
+    {
+        uint8_t* memory{nullptr};
+        size_t   size{0};
+        size_t   used{0};
+    };
+
+    static constexpr size_t BLOCK_SIZE = 4096;
+
+    void*    allocate(size_t size, size_t alignment);
+    EntityId resolve(EntityId id) const;
+    void     reset();
+
+private:
+    std::vector<Command>  m_Commands;
+    std::vector<EntityId> m_CreatedEntities;
+    uint32_t              m_PlaceholdersCount{0};
+
+    /* Component arguments are stored in blocks, which never move, so payloads are never relocated */
+    std::vector<Block> m_Blocks;
+    size_t             m_CurrentBlock{0};
+};
+
+} // namespace gwars
+
+#include "ecs/command_buffer.ipp"
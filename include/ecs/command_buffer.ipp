@@ -0,0 +1,91 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file command_buffer.ipp
+ * @date 2026-10-16
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cassert>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace gwars {
+
+template<typename T, typename... Args>
+void CommandBuffer::createComponent(EntityId id, Args&&... args)
+{
+    Command command;
+    command.type    = CommandType::CreateComponent;
+    command.entity  = id;
+    command.payload = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    command.apply   = [](EntityManager& manager, EntityId entity, void* payload) {
+        manager.createComponent<T>(entity, std::move(*static_cast<T*>(payload)));
+    };
+    command.destroy = [](void* payload) { static_cast<T*>(payload)->~T(); };
+
+    m_Commands.push_back(command);
+}
+
+template<typename T>
+void CommandBuffer::removeComponent(EntityId id)
+{
+    Command command;
+    command.type   = CommandType::RemoveComponent;
+    command.entity = id;
+    command.apply  = [](EntityManager& manager, EntityId entity, void*) {
+        if (manager.hasComponent<T>(entity))
+        {
+            manager.removeComponent<T>(entity);
+        }
+    };
+
+    m_Commands.push_back(command);
+}
+
+template<typename Initializer>
+void CommandBuffer::instantiate(const Prefab& prefab, size_t count, Initializer&& initializer)
+{
+    struct Payload
+    {
+        const Prefab*             prefab;
+        size_t                    count;
+        std::decay_t<Initializer> initializer;
+    };
+
+    Command command;
+    command.type    = CommandType::Instantiate;
+    command.payload = new (allocate(sizeof(Payload), alignof(Payload)))
+        Payload{&prefab, count, std::forward<Initializer>(initializer)};
+    command.apply   = [](EntityManager& manager, EntityId, void* payload) {
+        Payload& instantiation = *static_cast<Payload*>(payload);
+        gwars::instantiate(manager, *instantiation.prefab, instantiation.count, instantiation.initializer);
+    };
+    command.destroy = [](void* payload) { static_cast<Payload*>(payload)->~Payload(); };
+
+    m_Commands.push_back(command);
+}
+
+} // namespace gwars
@@ -0,0 +1,280 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file component_pool.hpp
+ * @date 2026-10-16
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include "ecs/component_signature.hpp"
+#include "ecs/entity_id.hpp"
+#include "events/event_dispatcher.hpp"
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+namespace gwars {
+
+template<typename T>
+struct EventComponentConstruct
+{
+    T&       component;
+    EntityId entityId;
+
+    EventComponentConstruct(T& component, EntityId entityId);
+};
+
+template<typename T>
+struct EventComponentRemove
+{
+    T&       component;
+    EntityId entityId;
+
+    EventComponentRemove(T& component, EntityId entityId);
+};
+
+template<typename T>
+class ComponentPool;
+
+/**
+ * @brief Fired once for a whole batch of components being removed at once (see EntityManager::clear
+ *        and EntityManager::destroyEntities) instead of EventComponentRemove<T> per component.
+ *
+ * @warning Handlers must not make structural changes.
+ */
+template<typename T>
+struct EventComponentRemoveBatch
+{
+    ComponentPool<T>& pool;
+    const EntityId*   entities;
+    size_t            count;
+
+    EventComponentRemoveBatch(ComponentPool<T>& pool, const EntityId* entities, size_t count);
+};
+
+/**
+ * @brief Memory and usage statistics of a component pool, see EntityManager::getStats.
+ *
+ * Bytes include the pool's arrays and the heap memory owned by components, which components report
+ * through an optional `size_t getHeapBytes() const` member (e.g. particle pools).
+ */
+struct ComponentPoolStats
+{
+    ComponentTypeId typeId{INVALID_COMPONENT_ID};
+    const char*     typeName{nullptr};
+
+    size_t count{0};
+    size_t capacity{0};
+    size_t highWaterMark{0};
+
+    size_t bytesUsed{0};
+    size_t bytesReserved{0};
+
+    size_t allocationsCount{0};
+    size_t frameAllocationsCount{0};
+};
+
+/**
+ * @brief Type-independent part of a component pool, maps entity ids to dense indices.
+ *
+ * The sparse array is indexed by entity's slot index (see getEntityIndex) and stores the entity's
+ * position in the dense array, the dense array stores entity ids contiguously. Removal moves the last
+ * entity into the freed slot (swap-and-pop), so the dense array never has holes.
+ *
+ * Arrays never shrink, so once a pool has grown to the peak number of components, creating and
+ * removing components doesn't allocate memory. Every (re)allocation is counted, see
+ * getAllocationsCount().
+ *
+ * Every element also stores the version of its latest change. The pool's version is incremented on
+ * each change, so a system can remember getVersion() after it has run and next time process only the
+ * elements, which have changed since then (see isChangedSince). Insertion counts as a change.
+ *
+ * The set also keeps its type's bit in the entities' signatures (owned by the EntityManager) in sync
+ * with its contents.
+ */
+class SparseSet
+{
+public:
+    SparseSet(ComponentTypeId typeId, std::vector<ComponentSignature>& signatures);
+    virtual ~SparseSet() = default;
+
+    /**
+     * @brief Fires EventComponentRemove<T> and then removes the entity's component.
+     */
+    virtual void remove(EntityId id) = 0;
+
+    /**
+     * @brief Fires EventComponentRemoveBatch<T> for the given entities, which must be in the set.
+     */
+    virtual void fireRemoveBatch(const EntityId* entities, size_t count) = 0;
+
+    /**
+     * @brief Removes the entity's component without firing any events.
+     */
+    virtual void release(EntityId id) = 0;
+
+    /**
+     * @brief Removes all elements at once without firing any events, keeps the allocated memory.
+     */
+    virtual void clear();
+
+    /**
+     * @return Contiguous array of size() entity ids.
+     */
+    const EntityId* getEntities() const;
+
+    bool   contains(EntityId id) const;
+    size_t size() const;
+    size_t capacity() const;
+
+    EntityId getEntity(size_t index) const;
+    size_t   getIndex(EntityId id) const;
+
+    /**
+     * @return Version of the latest change made to any element of the pool.
+     */
+    uint64_t getVersion() const;
+
+    bool isChangedSince(EntityId id, uint64_t version) const;
+    void markChanged(size_t index);
+
+    /**
+     * @brief Preallocates storage for the given number of elements, the sparse array is preallocated for
+     *        entities with slot indices up to the same number.
+     */
+    virtual void reserve(size_t capacity);
+
+    /**
+     * @return Number of times the pool's storage has been allocated or reallocated.
+     */
+    size_t getAllocationsCount() const;
+
+    virtual ComponentPoolStats getStats() const;
+
+    /**
+     * @brief Starts a new frame for ComponentPoolStats::frameAllocationsCount.
+     */
+    void resetFrameStats();
+
+protected:
+    static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+    /**
+     * @brief Fills the empty set with the given entities at once.
+     */
+    void assign(const EntityId* entities, size_t count);
+
+    /**
+     * @return Index in the dense array at which the entity was inserted.
+     */
+    uint32_t insert(EntityId id);
+
+    /**
+     * @return Index of the dense array's element, which has been moved into the erased one's place.
+     */
+    uint32_t erase(EntityId id);
+
+    template<typename Container>
+    void countReallocation(const Container& container, size_t previousCapacity);
+
+private:
+    ComponentTypeId                  m_TypeId;
+    std::vector<ComponentSignature>& m_Signatures;
+
+    std::vector<uint32_t> m_Sparse;
+    std::vector<EntityId> m_Dense;
+    std::vector<uint64_t> m_Versions;
+    uint64_t              m_Version{0};
+    size_t                m_HighWaterMark{0};
+    size_t                m_AllocationsCount{0};
+    size_t                m_FrameAllocationsBase{0};
+};
+
+/**
+ * @brief Sparse set of components of type T.
+ *
+ * Components are stored contiguously in the same order as entities in the dense array, which is what
+ * views iterate over.
+ *
+ * @warning References to components are invalidated by any structural change to the pool.
+ *
+ * @tparam T Component type.
+ */
+template<typename T>
+class ComponentPool : public SparseSet
+{
+public:
+    ComponentPool(EventDispatcher& eventDispatcher, std::vector<ComponentSignature>& signatures);
+    ~ComponentPool() override = default;
+
+    template<typename... Args>
+    T& emplace(EntityId id, Args&&... args);
+
+    void remove(EntityId id) override;
+    void fireRemoveBatch(const EntityId* entities, size_t count) override;
+    void release(EntityId id) override;
+    void clear() override;
+    void reserve(size_t capacity) override;
+
+    ComponentPoolStats getStats() const override;
+
+    /**
+     * @brief Fills the empty pool with copies of the components, which for trivially copyable T is a
+     *        plain memory copy. Construct events are fired afterwards only if there are handlers
+     *        (e.g. queries) to keep in sync.
+     */
+    void assign(const EntityId* entities, const T* components, size_t count);
+
+    /**
+     * @return Contiguous array of size() components in the same order as getEntities().
+     */
+    const T* getComponents() const;
+
+    /**
+     * @brief Raw access, which doesn't mark the component as changed, see modify().
+     */
+    T&       get(EntityId id);
+    const T& get(EntityId id) const;
+    T&       getComponent(size_t index);
+
+    /**
+     * @brief Marks the component as changed and returns it.
+     */
+    T& modify(EntityId id);
+
+private:
+    std::vector<T>   m_Components;
+    EventDispatcher& m_EventDispatcher;
+};
+
+/**
+ * @brief Returns entity's component for reading (T is const) or writing. Only the latter marks the
+ *        component as changed.
+ */
+template<typename T>
+T& accessComponent(ComponentPool<std::remove_const_t<T>>& pool, EntityId id);
+
+} // namespace gwars
+
+#include "ecs/component_pool.ipp"
@@ -0,0 +1,417 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file component_pool.ipp
+ * @date 2026-10-16
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace gwars {
+
+template<typename T>
+EventComponentConstruct<T>::EventComponentConstruct(T& component, EntityId entityId)
+    : component(component), entityId(entityId)
+{
+}
+
+template<typename T>
+EventComponentRemove<T>::EventComponentRemove(T& component, EntityId entityId)
+    : component(component), entityId(entityId)
+{
+}
+
+template<typename T>
+EventComponentRemoveBatch<T>::EventComponentRemoveBatch(ComponentPool<T>& pool, const EntityId* entities, size_t count)
+    : pool(pool), entities(entities), count(count)
+{
+}
+
+inline SparseSet::SparseSet(ComponentTypeId typeId, std::vector<ComponentSignature>& signatures)
+    : m_TypeId(typeId), m_Signatures(signatures)
+{
+}
+
+inline bool SparseSet::contains(EntityId id) const
+{
+    const uint32_t index = getEntityIndex(id);
+    return index < m_Sparse.size() && m_Sparse[index] != INVALID_INDEX && m_Dense[m_Sparse[index]] == id;
+}
+
+inline size_t SparseSet::size() const
+{
+    return m_Dense.size();
+}
+
+inline size_t SparseSet::capacity() const
+{
+    return m_Dense.capacity();
+}
+
+inline void SparseSet::clear()
+{
+    for (EntityId id : m_Dense)
+    {
+        m_Sparse[getEntityIndex(id)] = INVALID_INDEX;
+        m_Signatures[getEntityIndex(id)].reset(m_TypeId);
+    }
+
+    m_Dense.clear();
+    m_Versions.clear();
+}
+
+inline const EntityId* SparseSet::getEntities() const
+{
+    return m_Dense.data();
+}
+
+inline EntityId SparseSet::getEntity(size_t index) const
+{
+    assert(index < m_Dense.size());
+    return m_Dense[index];
+}
+
+inline size_t SparseSet::getIndex(EntityId id) const
+{
+    assert(contains(id));
+    return m_Sparse[getEntityIndex(id)];
+}
+
+inline uint64_t SparseSet::getVersion() const
+{
+    return m_Version;
+}
+
+inline bool SparseSet::isChangedSince(EntityId id, uint64_t version) const
+{
+    return m_Versions[getIndex(id)] > version;
+}
+
+inline void SparseSet::markChanged(size_t index)
+{
+    assert(index < m_Versions.size());
+    m_Versions[index] = ++m_Version;
+}
+
+inline void SparseSet::reserve(size_t capacity)
+{
+    /* Slot 0 is never used by entities */
+    const size_t sparseCapacity = m_Sparse.capacity();
+    m_Sparse.reserve(capacity + 1);
+    countReallocation(m_Sparse, sparseCapacity);
+
+    const size_t denseCapacity = m_Dense.capacity();
+    m_Dense.reserve(capacity);
+    countReallocation(m_Dense, denseCapacity);
+
+    const size_t versionsCapacity = m_Versions.capacity();
+    m_Versions.reserve(capacity);
+    countReallocation(m_Versions, versionsCapacity);
+}
+
+inline size_t SparseSet::getAllocationsCount() const
+{
+    return m_AllocationsCount;
+}
+
+inline ComponentPoolStats SparseSet::getStats() const
+{
+    ComponentPoolStats stats;
+    stats.typeId                = m_TypeId;
+    stats.count                 = m_Dense.size();
+    stats.capacity              = m_Dense.capacity();
+    stats.highWaterMark         = m_HighWaterMark;
+    stats.bytesUsed             = m_Dense.size() * (sizeof(EntityId) + sizeof(uint64_t))
+                                  + m_Sparse.size() * sizeof(uint32_t);
+    stats.bytesReserved         = m_Dense.capacity() * sizeof(EntityId) + m_Versions.capacity() * sizeof(uint64_t)
+                                  + m_Sparse.capacity() * sizeof(uint32_t);
+    stats.allocationsCount      = m_AllocationsCount;
+    stats.frameAllocationsCount = m_AllocationsCount - m_FrameAllocationsBase;
+
+    return stats;
+}
+
+inline void SparseSet::resetFrameStats()
+{
+    m_FrameAllocationsBase = m_AllocationsCount;
+}
+
+inline uint32_t SparseSet::insert(EntityId id)
+{
+    assert(!contains(id));
+
+    const uint32_t index = getEntityIndex(id);
+    if (index >= m_Sparse.size())
+    {
+        const size_t sparseCapacity = m_Sparse.capacity();
+        m_Sparse.resize(index + 1, INVALID_INDEX);
+        countReallocation(m_Sparse, sparseCapacity);
+    }
+
+    const size_t denseCapacity    = m_Dense.capacity();
+    const size_t versionsCapacity = m_Versions.capacity();
+
+    m_Sparse[index] = static_cast<uint32_t>(m_Dense.size());
+    m_Dense.push_back(id);
+    m_Versions.push_back(++m_Version);
+    m_HighWaterMark = std::max(m_HighWaterMark, m_Dense.size());
+
+    assert(index < m_Signatures.size());
+    m_Signatures[index].set(m_TypeId);
+
+    countReallocation(m_Dense, denseCapacity);
+    countReallocation(m_Versions, versionsCapacity);
+
+    return m_Sparse[index];
+}
+
+inline void SparseSet::assign(const EntityId* entities, size_t count)
+{
+    assert(m_Dense.empty());
+
+    const size_t denseCapacity    = m_Dense.capacity();
+    const size_t versionsCapacity = m_Versions.capacity();
+    const size_t sparseCapacity   = m_Sparse.capacity();
+
+    m_Dense.assign(entities, entities + count);
+    m_Versions.assign(count, ++m_Version);
+    m_HighWaterMark = std::max(m_HighWaterMark, count);
+
+    for (size_t position = 0; position < count; ++position)
+    {
+        const uint32_t index = getEntityIndex(entities[position]);
+        if (index >= m_Sparse.size())
+        {
+            m_Sparse.resize(index + 1, INVALID_INDEX);
+        }
+
+        assert(index < m_Signatures.size());
+        m_Sparse[index] = static_cast<uint32_t>(position);
+        m_Signatures[index].set(m_TypeId);
+    }
+
+    countReallocation(m_Dense, denseCapacity);
+    countReallocation(m_Versions, versionsCapacity);
+    countReallocation(m_Sparse, sparseCapacity);
+}
+
+inline uint32_t SparseSet::erase(EntityId id)
+{
+    assert(contains(id));
+
+    uint32_t position = m_Sparse[getEntityIndex(id)];
+    uint32_t last     = static_cast<uint32_t>(m_Dense.size() - 1);
+
+    m_Dense[position]                           = m_Dense[last];
+    m_Versions[position]                        = m_Versions[last];
+    m_Sparse[getEntityIndex(m_Dense[position])] = position;
+
+    m_Dense.pop_back();
+    m_Versions.pop_back();
+    m_Sparse[getEntityIndex(id)] = INVALID_INDEX;
+
+    m_Signatures[getEntityIndex(id)].reset(m_TypeId);
+
+    return last;
+}
+
+template<typename Container>
+void SparseSet::countReallocation(const Container& container, size_t previousCapacity)
+{
+    if (container.capacity() != previousCapacity)
+    {
+        ++m_AllocationsCount;
+    }
+}
+
+template<typename T>
+ComponentPool<T>::ComponentPool(EventDispatcher& eventDispatcher, std::vector<ComponentSignature>& signatures)
+    : SparseSet(ComponentType<T>::getId(), signatures), m_EventDispatcher(eventDispatcher)
+{
+}
+
+template<typename T>
+template<typename... Args>
+T& ComponentPool<T>::emplace(EntityId id, Args&&... args)
+{
+    insert(id);
+
+    const size_t capacity = m_Components.capacity();
+    m_Components.emplace_back(std::forward<Args>(args)...);
+    countReallocation(m_Components, capacity);
+
+    return m_Components.back();
+}
+
+template<typename T>
+void ComponentPool<T>::remove(EntityId id)
+{
+    m_EventDispatcher.getSink<EventComponentRemove<T>>().fireEvent(EventComponentRemove<T>(get(id), id));
+
+    /* Handlers may have changed the pool, so the index is looked up only after firing the event */
+    release(id);
+}
+
+template<typename T>
+void ComponentPool<T>::fireRemoveBatch(const EntityId* entities, size_t count)
+{
+    EventSink<EventComponentRemoveBatch<T>>& sink = m_EventDispatcher.getSink<EventComponentRemoveBatch<T>>();
+    if (count > 0 && sink.hasHandlers())
+    {
+        sink.fireEvent(EventComponentRemoveBatch<T>(*this, entities, count));
+    }
+}
+
+template<typename T>
+void ComponentPool<T>::release(EntityId id)
+{
+    size_t   index = getIndex(id);
+    uint32_t moved = erase(id);
+
+    if (index != moved)
+    {
+        m_Components[index] = std::move(m_Components[moved]);
+    }
+
+    m_Components.pop_back();
+}
+
+template<typename T, typename = void>
+struct HasHeapBytes : std::false_type
+{
+};
+
+template<typename T>
+struct HasHeapBytes<T, std::void_t<decltype(std::declval<const T&>().getHeapBytes())>> : std::true_type
+{
+};
+
+template<typename T>
+ComponentPoolStats ComponentPool<T>::getStats() const
+{
+    ComponentPoolStats stats = SparseSet::getStats();
+    stats.typeName           = typeid(T).name();
+
+    stats.bytesUsed += m_Components.size() * sizeof(T);
+    stats.bytesReserved += m_Components.capacity() * sizeof(T);
+
+    if constexpr (HasHeapBytes<T>::value)
+    {
+        for (const T& component : m_Components)
+        {
+            stats.bytesUsed     += component.getHeapBytes();
+            stats.bytesReserved += component.getHeapBytes();
+        }
+    }
+
+    return stats;
+}
+
+template<typename T>
+void ComponentPool<T>::clear()
+{
+    SparseSet::clear();
+    m_Components.clear();
+}
+
+template<typename T>
+void ComponentPool<T>::assign(const EntityId* entities, const T* components, size_t count)
+{
+    SparseSet::assign(entities, count);
+
+    const size_t capacity = m_Components.capacity();
+    m_Components.assign(components, components + count);
+    countReallocation(m_Components, capacity);
+
+    EventSink<EventComponentConstruct<T>>& sink = m_EventDispatcher.getSink<EventComponentConstruct<T>>();
+    if (sink.hasHandlers())
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            sink.fireEvent(EventComponentConstruct<T>(m_Components[i], entities[i]));
+        }
+    }
+}
+
+template<typename T>
+const T* ComponentPool<T>::getComponents() const
+{
+    return m_Components.data();
+}
+
+template<typename T>
+void ComponentPool<T>::reserve(size_t capacity)
+{
+    SparseSet::reserve(capacity);
+
+    const size_t componentsCapacity = m_Components.capacity();
+    m_Components.reserve(capacity);
+    countReallocation(m_Components, componentsCapacity);
+}
+
+template<typename T>
+T& ComponentPool<T>::get(EntityId id)
+{
+    return m_Components[getIndex(id)];
+}
+
+template<typename T>
+const T& ComponentPool<T>::get(EntityId id) const
+{
+    return m_Components[getIndex(id)];
+}
+
+template<typename T>
+T& ComponentPool<T>::modify(EntityId id)
+{
+    size_t index = getIndex(id);
+    markChanged(index);
+
+    return m_Components[index];
+}
+
+template<typename T>
+T& ComponentPool<T>::getComponent(size_t index)
+{
+    assert(index < m_Components.size());
+    return m_Components[index];
+}
+
+template<typename T>
+T& accessComponent(ComponentPool<std::remove_const_t<T>>& pool, EntityId id)
+{
+    if constexpr (std::is_const_v<T>)
+    {
+        return pool.get(id);
+    }
+    else
+    {
+        return pool.modify(id);
+    }
+}
+
+} // namespace gwars
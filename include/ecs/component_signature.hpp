@@ -0,0 +1,87 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file component_signature.hpp
+ * @date 2026-10-16
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+
+#include "ecs/component_type.hpp"
+#include <stddef.h>
+
+namespace gwars {
+
+constexpr size_t MAX_COMPONENT_TYPES = 128;
+
+/**
+ * @brief Fixed-width set of component types, one bit per ComponentTypeId.
+ *
+ * Every entity carries one, so checking whether an entity has a component is a bit test and matching
+ * an entity against a set of components is a few word ANDs.
+ */
+class ComponentSignature
+{
+public:
+    void set(ComponentTypeId typeId);
+    void reset(ComponentTypeId typeId);
+    void clear();
+
+    /**
+     * @brief Adds all types of the other signature to this one.
+     */
+    void merge(const ComponentSignature& other);
+
+    bool test(ComponentTypeId typeId) const;
+    bool any() const;
+
+    /**
+     * @return Whether all types of the other signature are also in this one.
+     */
+    bool contains(const ComponentSignature& other) const;
+    bool intersects(const ComponentSignature& other) const;
+
+    /**
+     * @return Smallest type id in the set, INVALID_COMPONENT_ID if the set is empty.
+     */
+    ComponentTypeId first() const;
+
+    size_t hash() const;
+
+    bool operator==(const ComponentSignature& other) const;
+    bool operator!=(const ComponentSignature& other) const;
+
+    template<typename... Ts>
+    static ComponentSignature create();
+
+private:
+    static constexpr size_t WORD_BITS   = 64;
+    static constexpr size_t WORDS_COUNT = MAX_COMPONENT_TYPES / WORD_BITS;
+
+    uint64_t m_Words[WORDS_COUNT]{};
+};
+
+} // namespace gwars
+
+#include "ecs/component_signature.ipp"
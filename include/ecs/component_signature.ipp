@@ -0,0 +1,156 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file component_signature.ipp
+ * @date 2026-10-16
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <cassert>
+
+namespace gwars {
+
+inline void ComponentSignature::set(ComponentTypeId typeId)
+{
+    assert(typeId < MAX_COMPONENT_TYPES);
+    m_Words[typeId / WORD_BITS] |= uint64_t{1} << (typeId % WORD_BITS);
+}
+
+inline void ComponentSignature::reset(ComponentTypeId typeId)
+{
+    assert(typeId < MAX_COMPONENT_TYPES);
+    m_Words[typeId / WORD_BITS] &= ~(uint64_t{1} << (typeId % WORD_BITS));
+}
+
+inline void ComponentSignature::clear()
+{
+    for (uint64_t& word : m_Words)
+    {
+        word = 0;
+    }
+}
+
+inline void ComponentSignature::merge(const ComponentSignature& other)
+{
+    for (size_t i = 0; i < WORDS_COUNT; ++i)
+    {
+        m_Words[i] |= other.m_Words[i];
+    }
+}
+
+inline bool ComponentSignature::test(ComponentTypeId typeId) const
+{
+    assert(typeId < MAX_COMPONENT_TYPES);
+    return (m_Words[typeId / WORD_BITS] >> (typeId % WORD_BITS)) & 1;
+}
+
+inline bool ComponentSignature::any() const
+{
+    for (uint64_t word : m_Words)
+    {
+        if (word != 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+inline bool ComponentSignature::contains(const ComponentSignature& other) const
+{
+    for (size_t i = 0; i < WORDS_COUNT; ++i)
+    {
+        if ((m_Words[i] & other.m_Words[i]) != other.m_Words[i])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+inline bool ComponentSignature::intersects(const ComponentSignature& other) const
+{
+    for (size_t i = 0; i < WORDS_COUNT; ++i)
+    {
+        if ((m_Words[i] & other.m_Words[i]) != 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+inline ComponentTypeId ComponentSignature::first() const
+{
+    for (size_t i = 0; i < WORDS_COUNT; ++i)
+    {
+        if (m_Words[i] != 0)
+        {
+            return static_cast<ComponentTypeId>(i * WORD_BITS + __builtin_ctzll(m_Words[i]));
+        }
+    }
+
+    return INVALID_COMPONENT_ID;
+}
+
+inline size_t ComponentSignature::hash() const
+{
+    uint64_t hash = 0;
+    for (uint64_t word : m_Words)
+    {
+        hash = (hash ^ word) * 0x9E3779B97F4A7C15ull;
+    }
+
+    return static_cast<size_t>(hash ^ (hash >> 32));
+}
+
+inline bool ComponentSignature::operator==(const ComponentSignature& other) const
+{
+    for (size_t i = 0; i < WORDS_COUNT; ++i)
+    {
+        if (m_Words[i] != other.m_Words[i])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+inline bool ComponentSignature::operator!=(const ComponentSignature& other) const { return !(*this == other); }
+
+template<typename... Ts>
+ComponentSignature ComponentSignature::create()
+{
+    ComponentSignature signature;
+    (signature.set(ComponentType<Ts>::getId()), ...);
+
+    return signature;
+}
+
+} // namespace gwars
@@ -1,6 +1,6 @@
 /**
  * @author Nikita Mochalov (github.com/tralf-strues)
- * @file component_holder.hpp
+ * @file component_type.hpp
  * @date 2022-05-21
  *
  * The MIT License (MIT)
@@ -31,32 +31,26 @@
 
 namespace gwars {
 
-using ComponentTypeId                          = uint64_t;
+using ComponentTypeId                          = uint32_t;
 constexpr ComponentTypeId INVALID_COMPONENT_ID = 0;
 
-class IComponentHolder
+struct ComponentTypeIdGenerator
 {
-public:
-    virtual ~IComponentHolder() = default;
+    static ComponentTypeId nextId();
 };
 
+/**
+ * @brief Assigns every component type a small dense id on first use, so that per-type data (e.g.
+ *        component pools) can be stored in flat arrays indexed by the id.
+ *
+ * cv-qualified types share the id with the unqualified type.
+ */
 template<typename T>
-class ComponentHolder : public IComponentHolder
+struct ComponentType
 {
-public:
-    template<typename... Args>
-    ComponentHolder(Args&&... args);
-
-    ~ComponentHolder() override = default;
-
-    T& get();
-    static ComponentTypeId getTypeId();
-
-protected:
-    static ComponentTypeId s_TypeId;
-    T m_Component;
+    static ComponentTypeId getId();
 };
 
 } // namespace gwars
 
-#include "ecs/component_holder.ipp"
\ No newline at end of file
+#include "ecs/component_type.ipp"
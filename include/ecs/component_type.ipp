@@ -1,21 +1,21 @@
 /**
  * @author Nikita Mochalov (github.com/tralf-strues)
- * @file component_holder.cpp
- * @date 2022-05-23
- * 
+ * @file component_type.ipp
+ * @date 2022-05-22
+ *
  * The MIT License (MIT)
  * Copyright (c) 2022 Nikita Mochalov
- * 
+ *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
  * to deal in the Software without restriction, including without limitation
  * the rights to use, copy, modify, merge, publish, distribute, sublicense,
  * and/or sell copies of the Software, and to permit persons to whom the
  * Software is furnished to do so, subject to the following conditions:
- * 
+ *
  * The above copyright notice and this permission notice shall be included in
  * all copies or substantial portions of the Software.
- * 
+ *
  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
  * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
@@ -25,10 +25,24 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
-#include "ecs/component_holder.hpp"
+#pragma once
+
+#include <type_traits>
 
 namespace gwars {
 
-uint32_t s_NextComponentTypeId{1};
+template<typename T>
+ComponentTypeId ComponentType<T>::getId()
+{
+    if constexpr (std::is_same_v<T, std::remove_cv_t<T>>)
+    {
+        static const ComponentTypeId id = ComponentTypeIdGenerator::nextId();
+        return id;
+    }
+    else
+    {
+        return ComponentType<std::remove_cv_t<T>>::getId();
+    }
+}
 
-} // namespace gwars
\ No newline at end of file
+} // namespace gwars
@@ -41,6 +41,14 @@ public:
 
     void destroy();
 
+    EntityId getId() const;
+
+    /**
+     * @return Whether the entity still exists. Handles to destroyed entities are safe to keep and
+     *         query with this method.
+     */
+    bool isAlive() const;
+
     template<typename T, typename... Args>
     void createComponent(Args&&... args);
 
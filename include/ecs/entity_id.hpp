@@ -0,0 +1,67 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file entity_id.hpp
+ * @date 2026-10-16
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+namespace gwars {
+
+/**
+ * @brief Compact entity handle, which consists of a slot index (lower bits) and the slot's generation
+ *        (upper bits).
+ *
+ * Slot indices are recycled after entities are destroyed, so they stay dense and can be used to index
+ * arrays directly. The generation is incremented every time a slot is released, which makes handles
+ * to destroyed entities detectable. A slot whose generation reaches MAX_ENTITY_GENERATION is retired
+ * instead of wrapping around, so a stale handle can never match a new entity. That costs at most one
+ * slot per 4095 destructions of entities in the same slot.
+ */
+using EntityId = uint32_t;
+
+constexpr uint32_t ENTITY_INDEX_BITS      = 20;
+constexpr uint32_t ENTITY_GENERATION_BITS = 32 - ENTITY_INDEX_BITS;
+constexpr uint32_t ENTITY_INDEX_MASK      = (1u << ENTITY_INDEX_BITS) - 1;
+constexpr uint32_t ENTITY_GENERATION_MASK = (1u << ENTITY_GENERATION_BITS) - 1;
+constexpr uint32_t MAX_ENTITIES           = ENTITY_INDEX_MASK;
+
+/* The highest generation is never given to entities, it tags placeholder ids (see CommandBuffer) */
+constexpr uint32_t MAX_ENTITY_GENERATION         = ENTITY_GENERATION_MASK - 1;
+constexpr uint32_t PLACEHOLDER_ENTITY_GENERATION = ENTITY_GENERATION_MASK;
+
+/* Index 0 is never allocated, so INVALID_ENTITY_ID can't be a handle to an existing entity */
+constexpr EntityId INVALID_ENTITY_ID = 0;
+
+constexpr uint32_t getEntityIndex(EntityId id) { return id & ENTITY_INDEX_MASK; }
+constexpr uint32_t getEntityGeneration(EntityId id) { return id >> ENTITY_INDEX_BITS; }
+
+constexpr EntityId makeEntityId(uint32_t index, uint32_t generation)
+{
+    return ((generation & ENTITY_GENERATION_MASK) << ENTITY_INDEX_BITS) | (index & ENTITY_INDEX_MASK);
+}
+
+} // namespace gwars
@@ -27,69 +27,200 @@
 
 #pragma once
 
-#include "ecs/component_holder.hpp"
+#include "ecs/component_pool.hpp"
+#include "ecs/component_type.hpp"
 #include "events/event_dispatcher.hpp"
-#include <unordered_map>
+#include "utils/binary_stream.hpp"
 
 namespace gwars {
 
-using EntityId                       = uint32_t;
-constexpr EntityId INVALID_ENTITY_ID = 0;
-
-using EntityMap    = std::unordered_map<EntityId, IComponentHolder*>;
-using ComponentMap = std::unordered_map<ComponentTypeId, IComponentHolder*>;
-
-template<typename T>
-struct EventComponentConstruct
+/**
+ * @brief Memory and usage statistics of an EntityManager, see EntityManager::getStats.
+ */
+struct EntityManagerStats
 {
-    T&       component;
-    EntityId entityId;
+    size_t entitiesCount{0};
 
-    EventComponentConstruct(T& component, EntityId entityId);
-};
+    /* Slots are never released, so their number is also the high-water mark of entities */
+    size_t slotsCount{0};
+    size_t slotsCapacity{0};
+    size_t bytesPerEntity{0};
+    size_t entitiesBytesReserved{0};
 
-template<typename T>
-struct EventComponentRemove
-{
-    T&       component;
-    EntityId entityId;
+    size_t allocationsCount{0};
+    size_t frameAllocationsCount{0};
 
-    EventComponentRemove(T& component, EntityId entityId);
+    size_t eventSinksCount{0};
+    size_t eventHandlersCount{0};
+
+    std::vector<ComponentPoolStats> pools;
 };
 
 class EntityManager
 {
 public:
+    ~EntityManager();
+
     EntityId createEntity();
     void     removeEntity(EntityId id);
 
+    /**
+     * @brief Creates count entities at once, entity slots are allocated once for the whole batch. The ids
+     *        are pushed onto the manager's spawn stack, which keeps its capacity, so that spawning batches
+     *        doesn't allocate memory in steady state.
+     *
+     * @return Position of the first created id, see getSpawnedEntities. The caller pops its ids with
+     *         popSpawnedEntities when done, batches created in the meantime (e.g. by initializers, see
+     *         gwars::instantiate) are pushed on top of them.
+     */
+    size_t createEntities(size_t count);
+
+    /**
+     * @return Ids on the spawn stack starting from the position, valid until the next createEntities().
+     */
+    const EntityId* getSpawnedEntities(size_t position) const;
+
+    /**
+     * @brief Pops the ids starting from the position off the spawn stack.
+     */
+    void popSpawnedEntities(size_t position);
+
+    /**
+     * @return Whether the handle refers to an existing entity, false for handles to destroyed ones.
+     */
+    bool isAlive(EntityId id) const;
+
+    /**
+     * @return Set of the component types the entity has.
+     */
+    const ComponentSignature& getSignature(EntityId id) const;
+
+    /**
+     * @brief Destroys all entities at once. Every pool fires a single EventComponentRemoveBatch<T>
+     *        (before any component is destroyed) and is then released as a whole.
+     */
     void clear();
 
+    /**
+     * @brief Destroys the given entities in a batch, see EventComponentRemoveBatch. Ids of entities that
+     *        are already dead, and repeated ids, are skipped.
+     */
+    void destroyEntities(const EntityId* ids, size_t idsCount);
+
+    /**
+     * @brief Writes entity slots (ids and the free list, not components, see ecs/snapshot.hpp).
+     */
+    void saveEntities(BinaryWriter& writer) const;
+
+    /**
+     * @brief Restores entity slots written by saveEntities, so that saved ids stay valid. The manager
+     *        must be empty (see clear()).
+     */
+    bool loadEntities(BinaryReader& reader);
+
+    /**
+     * @brief Preallocates entity slots, so that creating up to the given number of entities doesn't
+     *        allocate memory.
+     */
+    void reserveEntities(size_t capacity);
+
+    /**
+     * @brief Preallocates the pool of components T, so that creating up to the given number of
+     *        components doesn't allocate memory.
+     */
+    template<typename T>
+    void reserve(size_t capacity);
+
+    /**
+     * @return Number of memory allocations made by the manager's storage so far. Spawning and
+     *         destroying entities within already reached peak counts doesn't change it.
+     */
+    size_t getAllocationsCount() const;
+
+    /**
+     * @brief Collects entity and per-component-type statistics, including the pools' and their
+     *        components' memory. Walks all pools, so it is meant for diagnostics, not for every frame.
+     */
+    EntityManagerStats getStats() const;
+
+    /**
+     * @brief Prints getStats() to stdout.
+     */
+    void printStats() const;
+
+    /**
+     * @brief Starts a new frame for the frame allocation counters, called at the beginning of a frame.
+     */
+    void resetFrameStats();
+
     template<typename T, typename... Args>
     void createComponent(EntityId id, Args&&... args);
 
     template<typename T>
     void removeComponent(EntityId id);
 
+    /**
+     * @brief Returns the component and marks it as changed, unless T is const (e.g.
+     *        getComponent<const TransformComponent>), which gives read-only access.
+     */
     template<typename T>
     T& getComponent(EntityId id);
 
     template<typename T>
     bool hasComponent(EntityId id);
 
+    /**
+     * @brief Marks the component as changed, e.g. when it is modified through a reference obtained earlier.
+     */
     template<typename T>
-    EntityMap& getEntityMap();
+    void markChanged(EntityId id);
+
+    /**
+     * @return Version of the latest change to components T, see SparseSet.
+     */
+    template<typename T>
+    uint64_t getVersion();
+
+    template<typename T>
+    ComponentPool<T>& getPool();
 
     template<typename T>
     EventSink<EventComponentConstruct<T>>& onConstruct();
 
+    template<typename T>
+    EventSink<EventComponentRemove<T>>& onRemove();
+
+    template<typename T>
+    EventSink<EventComponentRemoveBatch<T>>& onRemoveBatch();
+
+private:
+    static bool isValidSlots(const EntityId* slots,
+                             size_t          slotsCount,
+                             const uint32_t* freeIndices,
+                             size_t          freeCount);
+
+    void releaseSlot(EntityId id);
+
 private:
-    std::unordered_map<EntityId, ComponentMap>     m_Entities;
-    std::unordered_map<ComponentTypeId, EntityMap> m_Components;
-    uint32_t                                       m_NextEntityId{1};
-    EventDispatcher                                m_EventDispatcher;
+    /**
+     * Current handle of every slot. Released slots store index 0 and the generation the slot is going
+     * to be reused with, retired slots (see releaseSlot) store INVALID_ENTITY_ID.
+     */
+    std::vector<EntityId>           m_Entities{INVALID_ENTITY_ID};
+    std::vector<ComponentSignature> m_Signatures{ComponentSignature{}};
+    std::vector<uint32_t>           m_FreeIndices;
+    size_t                          m_RetiredSlotsCount{0};
+    std::vector<EntityId>           m_BatchEntities;
+    std::vector<EntityId>           m_DestroyedEntities;
+    std::vector<EntityId>           m_SpawnedEntities;
+    size_t                          m_AllocationsCount{0};
+    size_t                          m_FrameAllocationsBase{0};
+
+    /* Indexed by ComponentTypeId, pools are created lazily */
+    std::vector<SparseSet*> m_Pools;
+    EventDispatcher         m_EventDispatcher;
 };
 
 } // namespace gwars
 
-#include "ecs/entity_manager.ipp"
\ No newline at end of file
+#include "ecs/entity_manager.ipp"
@@ -27,84 +27,79 @@
 
 #pragma once
 
-namespace gwars {
-
-template<typename T>
-EventComponentConstruct<T>::EventComponentConstruct(T& component, EntityId entityId)
-    : component(component), entityId(entityId)
-{
-}
+#include <cassert>
+#include <type_traits>
 
-template<typename T>
-EventComponentRemove<T>::EventComponentRemove(T& component, EntityId entityId)
-    : component(component), entityId(entityId)
-{
-}
+namespace gwars {
 
 template<typename T, typename... Args>
 void EntityManager::createComponent(EntityId id, Args&&... args)
 {
-    assert(m_Entities.find(id) != m_Entities.end());
+    assert(isAlive(id));
 
-    const ComponentTypeId componentTypeId = ComponentHolder<T>::getTypeId();
-    assert(m_Components[componentTypeId].find(id) == m_Components[componentTypeId].end());
+    T& component = getPool<T>().emplace(id, std::forward<Args>(args)...);
 
-    ComponentHolder<T>* componentHolder     = new ComponentHolder<T>(std::forward<Args>(args)...);
-    IComponentHolder*   baseComponentHolder = componentHolder;
-
-    m_Entities[id].emplace(componentTypeId, baseComponentHolder);
-    m_Components[componentTypeId].emplace(id, baseComponentHolder);
-
-    m_EventDispatcher.getSink<EventComponentConstruct<T>>().fireEvent(
-        EventComponentConstruct<T>(componentHolder->get(), id));
+    m_EventDispatcher.getSink<EventComponentConstruct<T>>().fireEvent(EventComponentConstruct<T>(component, id));
 }
 
 template<typename T>
 void EntityManager::removeComponent(EntityId id)
 {
-    assert(m_Entities.find(id) != m_Entities.end());
-
-    const ComponentTypeId componentTypeId = ComponentHolder<T>::GetTypeId();
-    assert(m_Components[componentTypeId].find(id) != m_Components[componentTypeId].end());
-
-    IComponentHolder* holderToRemove = m_Entities[id].find(componentTypeId)->second;
-
-    m_EventDispatcher.getSink<EventComponentRemove<T>>().fireEvent(
-        EventComponentRemove<T>(dynamic_cast<ComponentHolder<T>*>(holderToRemove)->get(), id));
+    assert(isAlive(id));
 
-    m_Components[componentTypeId].erase(id);
-    m_Entities[id].erase(componentTypeId);
-
-    delete holderToRemove;
+    getPool<T>().remove(id);
 }
 
 template<typename T>
 T& EntityManager::getComponent(EntityId id)
 {
-    assert(m_Entities.find(id) != m_Entities.end());
-
-    const ComponentTypeId componentTypeId = ComponentHolder<T>::getTypeId();
+    return accessComponent<T>(getPool<std::remove_const_t<T>>(), id);
+}
 
-    auto holderIterator = m_Components[componentTypeId].find(id);
-    assert(holderIterator != m_Components[componentTypeId].end());
+template<typename T>
+bool EntityManager::hasComponent(EntityId id)
+{
+    return isAlive(id) && m_Signatures[getEntityIndex(id)].test(ComponentType<T>::getId());
+}
 
-    return reinterpret_cast<ComponentHolder<T>*>(holderIterator->second)->get();
+template<typename T>
+void EntityManager::markChanged(EntityId id)
+{
+    ComponentPool<T>& pool = getPool<T>();
+    pool.markChanged(pool.getIndex(id));
 }
 
 template<typename T>
-bool EntityManager::hasComponent(EntityId id)
+uint64_t EntityManager::getVersion()
 {
-    assert(m_Entities.find(id) != m_Entities.end());
+    return getPool<T>().getVersion();
+}
 
-    const ComponentTypeId componentTypeId = ComponentHolder<T>::getTypeId();
-    return m_Components[componentTypeId].find(id) != m_Components[componentTypeId].end();
+template<typename T>
+void EntityManager::reserve(size_t capacity)
+{
+    getPool<T>().reserve(capacity);
 }
 
 template<typename T>
-EntityMap& EntityManager::getEntityMap()
+ComponentPool<T>& EntityManager::getPool()
 {
-    const ComponentTypeId componentTypeId = ComponentHolder<T>::getTypeId();
-    return m_Components[componentTypeId];
+    const ComponentTypeId componentTypeId = ComponentType<T>::getId();
+
+    if (componentTypeId >= m_Pools.size())
+    {
+        m_Pools.resize(componentTypeId + 1, nullptr);
+        ++m_AllocationsCount;
+    }
+
+    SparseSet*& pool = m_Pools[componentTypeId];
+    if (pool == nullptr)
+    {
+        pool = new ComponentPool<T>(m_EventDispatcher, m_Signatures);
+        ++m_AllocationsCount;
+    }
+
+    return *static_cast<ComponentPool<T>*>(pool);
 }
 
 template<typename T>
@@ -113,4 +108,16 @@ EventSink<EventComponentConstruct<T>>& EntityManager::onConstruct()
     return m_EventDispatcher.getSink<EventComponentConstruct<T>>();
 }
 
-} // namespace gwars
\ No newline at end of file
+template<typename T>
+EventSink<EventComponentRemove<T>>& EntityManager::onRemove()
+{
+    return m_EventDispatcher.getSink<EventComponentRemove<T>>();
+}
+
+template<typename T>
+EventSink<EventComponentRemoveBatch<T>>& EntityManager::onRemoveBatch()
+{
+    return m_EventDispatcher.getSink<EventComponentRemoveBatch<T>>();
+}
+
+} // namespace gwars
@@ -28,56 +28,120 @@
 #pragma once
 
 #include "ecs/entity.hpp"
+#include <tuple>
+#include <type_traits>
 
 namespace gwars {
 
+template<typename... Ts>
+struct Exclude
+{
+};
+
+/**
+ * @brief Exclusion filter for getView, e.g. getView<PolygonComponent>(manager, exclude<CameraComponent>).
+ */
+template<typename... Ts>
+inline constexpr Exclude<Ts...> exclude{};
+
+/**
+ * @brief Change filter for getView, keeps only entities whose component T has changed after the given
+ *        version, e.g. getView<BoundingSphereComponent, const TransformComponent>(manager,
+ *        changed<TransformComponent>(lastVersion)).
+ */
 template<typename T>
-class EntityView
+struct Changed
+{
+    uint64_t version{0};
+};
+
+template<typename T>
+Changed<T> changed(uint64_t version);
+
+template<typename Excluded, typename... Ts>
+class EntityView;
+
+/**
+ * @brief View of entities that have all of the components Ts and none of the components Excluded.
+ *
+ * Iteration is driven by the smallest of the pools of Ts, every candidate entity is then matched by
+ * its signature against the masks of included and excluded components. Components requested as const
+ * are read-only, the others are marked as changed when visited.
+ *
+ * @warning Components added while iterating are not visited, because end() is fixed to the
+ *          driving pool's size at the moment it is called.
+ */
+template<typename... Excluded, typename... Ts>
+class EntityView<Exclude<Excluded...>, Ts...>
 {
+    static_assert(sizeof...(Ts) > 0, "View must include at least one component type");
+
 public:
     class Iterator
     {
-    private:
-        using EntityMapIterator = typename std::unordered_map<EntityId, IComponentHolder*>::iterator;
-
     public:
-        Iterator(EntityMapIterator iterator, EntityManager& manager);
+        Iterator(const EntityView& view, size_t index);
 
         Iterator& operator++();
         Iterator  operator++(int);
 
-        T&     getComponent() const;
-        Entity getEntity() const;
+        Entity                     getEntity() const;
+        std::tuple<Entity, Ts&...> get() const;
 
     public:
-        friend bool operator==(const Iterator& lhs, const Iterator& rhs) { return lhs.m_Iterator == rhs.m_Iterator; }
+        friend bool operator==(const Iterator& lhs, const Iterator& rhs) { return lhs.m_Index == rhs.m_Index; }
+
+        friend bool operator!=(const Iterator& lhs, const Iterator& rhs) { return lhs.m_Index != rhs.m_Index; }
 
-        friend bool operator!=(const Iterator& lhs, const Iterator& rhs) { return lhs.m_Iterator != rhs.m_Iterator; }
+        friend std::tuple<Entity, Ts&...> operator*(const Iterator& it) { return it.get(); }
 
-        friend std::pair<Entity, T&> operator*(const Iterator& it)
-        {
-            return std::pair<Entity, T&>(it.getEntity(), it.getComponent());
-        }
+    private:
+        void skipInvalid();
 
     private:
-        EntityMapIterator m_Iterator;
-        EntityManager&    m_EntityManager;
+        const EntityView* m_View;
+        size_t            m_Index;
+        size_t            m_End;
     };
 
 public:
-    EntityView(EntityMap& entityMap, EntityManager& manager);
+    EntityView(EntityManager& manager, const SparseSet* changedPool = nullptr, uint64_t changedSince = 0);
+
+    Iterator begin() const;
+    Iterator end() const;
 
-    Iterator begin();
-    Iterator end();
+    /**
+     * @return Upper bound of the number of entities in the view.
+     */
+    size_t sizeHint() const;
+
+    EntityManager& getEntityManager() const;
+
+private:
+    bool isValid(EntityId id) const;
 
 private:
-    EntityMap&     m_EntityMap;
-    EntityManager& m_EntityManager;
+    std::tuple<ComponentPool<std::remove_const_t<Ts>>*...> m_Pools;
+    ComponentSignature                                     m_Mask;
+    ComponentSignature                                     m_ExcludedMask;
+    const SparseSet*                                       m_Driver;
+    const SparseSet*                                       m_ChangedPool;
+    uint64_t                                               m_ChangedSince;
+    EntityManager*                                         m_EntityManager;
 };
 
-template<typename T>
-EntityView<T> getView(EntityManager& manager);
+template<typename... Ts, typename... Excluded>
+EntityView<Exclude<Excluded...>, Ts...> getView(EntityManager& manager, Exclude<Excluded...> = {});
+
+template<typename... Ts, typename C, typename... Excluded>
+EntityView<Exclude<Excluded...>, Ts...> getView(EntityManager& manager, Changed<C> changed, Exclude<Excluded...> = {});
+
+/**
+ * @brief Destroys all entities of the view in a single batch, see EntityManager::destroyEntities.
+ */
+template<typename... Excluded, typename... Ts>
+void destroyAll(const EntityView<Exclude<Excluded...>, Ts...>& view);
 
 } // namespace gwars
 
-#include "ecs/entity_view.ipp"
\ No newline at end of file
+#include "ecs/entity_view.ipp"
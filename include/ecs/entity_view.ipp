@@ -30,61 +30,143 @@
 namespace gwars {
 
 template<typename T>
-EntityView<T>::Iterator::Iterator(EntityMapIterator iterator, EntityManager& manager)
-    : m_Iterator(iterator), m_EntityManager(manager)
+Changed<T> changed(uint64_t version)
 {
+    return Changed<T>{version};
 }
 
-template<typename T>
-typename EntityView<T>::Iterator& EntityView<T>::Iterator::operator++()
+template<typename... Excluded, typename... Ts>
+EntityView<Exclude<Excluded...>, Ts...>::Iterator::Iterator(const EntityView& view, size_t index)
+    : m_View(&view), m_Index(index), m_End(view.m_Driver->size())
 {
-    ++m_Iterator;
+    skipInvalid();
+}
+
+template<typename... Excluded, typename... Ts>
+typename EntityView<Exclude<Excluded...>, Ts...>::Iterator& EntityView<Exclude<Excluded...>, Ts...>::Iterator::
+operator++()
+{
+    ++m_Index;
+    skipInvalid();
+
     return *this;
 }
 
-template<typename T>
-typename EntityView<T>::Iterator EntityView<T>::Iterator::operator++(int)
+template<typename... Excluded, typename... Ts>
+typename EntityView<Exclude<Excluded...>, Ts...>::Iterator EntityView<Exclude<Excluded...>, Ts...>::Iterator::
+operator++(int)
 {
     Iterator temp{*this};
     ++(*this);
     return temp;
 }
 
-template<typename T>
-T& EntityView<T>::Iterator::getComponent() const
+template<typename... Excluded, typename... Ts>
+Entity EntityView<Exclude<Excluded...>, Ts...>::Iterator::getEntity() const
 {
-    ComponentHolder<T>* holder = reinterpret_cast<ComponentHolder<T>*>(m_Iterator->second);
-    assert(holder != nullptr);
-    return holder->get();
+    return Entity{m_View->m_Driver->getEntity(m_Index), *m_View->m_EntityManager};
 }
 
-template<typename T>
-Entity EntityView<T>::Iterator::getEntity() const
+template<typename... Excluded, typename... Ts>
+std::tuple<Entity, Ts&...> EntityView<Exclude<Excluded...>, Ts...>::Iterator::get() const
 {
-    return Entity{m_Iterator->first, m_EntityManager};
+    EntityId id = m_View->m_Driver->getEntity(m_Index);
+    return std::tuple<Entity, Ts&...>(
+        Entity{id, *m_View->m_EntityManager},
+        accessComponent<Ts>(*std::get<ComponentPool<std::remove_const_t<Ts>>*>(m_View->m_Pools), id)...);
 }
 
-template<typename T>
-EntityView<T>::EntityView(EntityMap& entityMap, EntityManager& manager) : m_EntityMap(entityMap), m_EntityManager(manager)
+template<typename... Excluded, typename... Ts>
+void EntityView<Exclude<Excluded...>, Ts...>::Iterator::skipInvalid()
 {
+    while (m_Index < m_End && !m_View->isValid(m_View->m_Driver->getEntity(m_Index)))
+    {
+        ++m_Index;
+    }
 }
 
-template<typename T>
-typename EntityView<T>::Iterator EntityView<T>::begin()
+template<typename... Excluded, typename... Ts>
+EntityView<Exclude<Excluded...>, Ts...>::EntityView(EntityManager&   manager,
+                                                    const SparseSet* changedPool,
+                                                    uint64_t         changedSince)
+    : m_Pools(&manager.getPool<std::remove_const_t<Ts>>()...),
+      m_Mask(ComponentSignature::create<Ts...>()),
+      m_ExcludedMask(ComponentSignature::create<Excluded...>()),
+      m_Driver(nullptr),
+      m_ChangedPool(changedPool),
+      m_ChangedSince(changedSince),
+      m_EntityManager(&manager)
 {
-    return Iterator{m_EntityMap.begin(), m_EntityManager};
+    const SparseSet* pools[] = {std::get<ComponentPool<std::remove_const_t<Ts>>*>(m_Pools)...};
+
+    m_Driver = pools[0];
+    for (const SparseSet* pool : pools)
+    {
+        if (pool->size() < m_Driver->size())
+        {
+            m_Driver = pool;
+        }
+    }
 }
 
-template<typename T>
-typename EntityView<T>::Iterator EntityView<T>::end()
+template<typename... Excluded, typename... Ts>
+typename EntityView<Exclude<Excluded...>, Ts...>::Iterator EntityView<Exclude<Excluded...>, Ts...>::begin() const
 {
-    return Iterator{m_EntityMap.end(), m_EntityManager};
+    return Iterator{*this, 0};
 }
 
-template<typename T>
-EntityView<T> getView(EntityManager& manager)
+template<typename... Excluded, typename... Ts>
+typename EntityView<Exclude<Excluded...>, Ts...>::Iterator EntityView<Exclude<Excluded...>, Ts...>::end() const
+{
+    return Iterator{*this, m_Driver->size()};
+}
+
+template<typename... Excluded, typename... Ts>
+size_t EntityView<Exclude<Excluded...>, Ts...>::sizeHint() const
+{
+    return m_Driver->size();
+}
+
+template<typename... Excluded, typename... Ts>
+EntityManager& EntityView<Exclude<Excluded...>, Ts...>::getEntityManager() const
+{
+    return *m_EntityManager;
+}
+
+template<typename... Excluded, typename... Ts>
+bool EntityView<Exclude<Excluded...>, Ts...>::isValid(EntityId id) const
+{
+    const ComponentSignature& signature = m_EntityManager->getSignature(id);
+
+    return signature.contains(m_Mask) && !signature.intersects(m_ExcludedMask)
+           && (m_ChangedPool == nullptr
+               || (m_ChangedPool->contains(id) && m_ChangedPool->isChangedSince(id, m_ChangedSince)));
+}
+
+template<typename... Ts, typename... Excluded>
+EntityView<Exclude<Excluded...>, Ts...> getView(EntityManager& manager, Exclude<Excluded...>)
 {
-    return EntityView<T>{manager.getEntityMap<T>(), manager};
+    return EntityView<Exclude<Excluded...>, Ts...>{manager};
+}
+
+template<typename... Ts, typename C, typename... Excluded>
+EntityView<Exclude<Excluded...>, Ts...> getView(EntityManager& manager, Changed<C> changed, Exclude<Excluded...>)
+{
+    return EntityView<Exclude<Excluded...>, Ts...>{manager, &manager.getPool<C>(), changed.version};
+}
+
+template<typename... Excluded, typename... Ts>
+void destroyAll(const EntityView<Exclude<Excluded...>, Ts...>& view)
+{
+    std::vector<EntityId> entities;
+    entities.reserve(view.sizeHint());
+
+    for (auto it = view.begin(); it != view.end(); ++it)
+    {
+        entities.push_back(it.getEntity().getId());
+    }
+
+    view.getEntityManager().destroyEntities(entities.data(), entities.size());
 }
 
-} // namespace gwars
\ No newline at end of file
+} // namespace gwars
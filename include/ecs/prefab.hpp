@@ -0,0 +1,103 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file prefab.hpp
+ * @date 2026-10-16
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+
+#include "ecs/entity.hpp"
+#include <stddef.h>
+#include <vector>
+
+namespace gwars {
+
+/**
+ * @brief Bundle of component prototypes, which is defined once and then instantiated any number of
+ *        times with instantiate().
+ *
+ * Components are copy-constructed from the prototypes, so they must be copyable. Per-instance data
+ * (e.g. position or a script) is filled in by instantiate()'s initializer.
+ */
+class Prefab
+{
+public:
+    Prefab() = default;
+    ~Prefab();
+
+    Prefab(const Prefab& other)            = delete;
+    Prefab& operator=(const Prefab& other) = delete;
+
+    /**
+     * @brief Adds a prototype of component T constructed from the arguments. Adding the same
+     *        component type twice is not allowed.
+     */
+    template<typename T, typename... Args>
+    Prefab& add(Args&&... args);
+
+    template<typename T>
+    bool has() const;
+
+    /**
+     * @brief Creates components of all prototypes for the given entities.
+     *
+     * Pools are grown once for the whole batch and construct events are only fired for component
+     * types, which have handlers.
+     */
+    void instantiate(EntityManager& manager, const EntityId* entities, size_t count) const;
+
+private:
+    using InstantiateFunction = void (*)(EntityManager& manager,
+                                         const EntityId* entities,
+                                         size_t          count,
+                                         const void*     prototype);
+    using DestroyFunction     = void (*)(void* prototype);
+
+    struct ComponentPrototype
+    {
+        ComponentTypeId     typeId{INVALID_COMPONENT_ID};
+        void*               prototype{nullptr};
+        InstantiateFunction instantiate{nullptr};
+        DestroyFunction     destroy{nullptr};
+    };
+
+private:
+    std::vector<ComponentPrototype> m_Prototypes;
+};
+
+/**
+ * @brief Creates count entities with the prefab's components in a single batch.
+ *
+ * @param initializer Called as initializer(Entity entity, size_t index) for every new entity after
+ *                    all prefab's components have been created.
+ */
+template<typename Initializer>
+void instantiate(EntityManager& manager, const Prefab& prefab, size_t count, Initializer&& initializer);
+
+void instantiate(EntityManager& manager, const Prefab& prefab, size_t count);
+
+} // namespace gwars
+
+#include "ecs/prefab.ipp"
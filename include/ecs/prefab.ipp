@@ -0,0 +1,110 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file prefab.ipp
+ * @date 2026-10-16
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace gwars {
+
+template<typename T, typename... Args>
+Prefab& Prefab::add(Args&&... args)
+{
+    static_assert(std::is_copy_constructible_v<T>, "Prefab components are copied into every instance");
+    assert(!has<T>());
+
+    ComponentPrototype prototype;
+    prototype.typeId      = ComponentType<T>::getId();
+    prototype.prototype   = new T(std::forward<Args>(args)...);
+    prototype.instantiate = [](EntityManager& manager, const EntityId* entities, size_t count, const void* prototype) {
+        ComponentPool<T>& pool      = manager.getPool<T>();
+        const T&          component = *static_cast<const T*>(prototype);
+
+        /* Grown geometrically, so that spawning one entity at a time doesn't reallocate on every spawn */
+        const size_t requiredCapacity = pool.size() + count;
+        if (requiredCapacity > pool.capacity())
+        {
+            pool.reserve(std::max(2 * pool.capacity(), requiredCapacity));
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            pool.emplace(entities[i], component);
+        }
+
+        EventSink<EventComponentConstruct<T>>& sink = manager.onConstruct<T>();
+        if (sink.hasHandlers())
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                sink.fireEvent(EventComponentConstruct<T>(pool.get(entities[i]), entities[i]));
+            }
+        }
+    };
+    prototype.destroy = [](void* prototype) { delete static_cast<T*>(prototype); };
+
+    m_Prototypes.push_back(prototype);
+    return *this;
+}
+
+template<typename T>
+bool Prefab::has() const
+{
+    const ComponentTypeId typeId = ComponentType<T>::getId();
+
+    for (const ComponentPrototype& prototype : m_Prototypes)
+    {
+        if (prototype.typeId == typeId)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+template<typename Initializer>
+void instantiate(EntityManager& manager, const Prefab& prefab, size_t count, Initializer&& initializer)
+{
+    /* The initializer may instantiate more entities, which may move the spawn stack, so ids are re-read */
+    const size_t position = manager.createEntities(count);
+    prefab.instantiate(manager, manager.getSpawnedEntities(position), count);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        initializer(Entity(manager.getSpawnedEntities(position)[i], manager), i);
+    }
+
+    manager.popSpawnedEntities(position);
+}
+
+} // namespace gwars
@@ -0,0 +1,148 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file query.hpp
+ * @date 2026-10-16
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include "ecs/entity_view.hpp"
+#include "events/connection.hpp"
+#include <vector>
+
+namespace gwars {
+
+template<typename Excluded, typename... Ts>
+class Query;
+
+/**
+ * @brief Persistent set of entities that have all of the components Ts and none of the components
+ *        Excluded, e.g. Query<Exclude<>, PhysicsComponent, TransformComponent>.
+ *
+ * Unlike EntityView, which matches candidate entities every time it is iterated, the query keeps a
+ * dense list of its members, which is updated incrementally on construct and remove events of the
+ * components involved. Iterating a query costs O(members) without any filtering, while every structural
+ * change to its components costs a signature test. It pays off for sets which are iterated every frame,
+ * but change rarely.
+ *
+ * Membership depends only on the entity's component types, not on component values. Components
+ * requested as const are read-only, the others are marked as changed when visited.
+ *
+ * @warning Members must not be added or removed while iterating. The query must be destroyed before
+ *          its entity manager.
+ */
+template<typename... Excluded, typename... Ts>
+class Query<Exclude<Excluded...>, Ts...>
+{
+    static_assert(sizeof...(Ts) > 0, "Query must include at least one component type");
+
+public:
+    class Iterator
+    {
+    public:
+        Iterator(const Query& query, size_t index);
+
+        Iterator& operator++();
+        Iterator  operator++(int);
+
+        Entity                     getEntity() const;
+        std::tuple<Entity, Ts&...> get() const;
+
+    public:
+        friend bool operator==(const Iterator& lhs, const Iterator& rhs) { return lhs.m_Index == rhs.m_Index; }
+
+        friend bool operator!=(const Iterator& lhs, const Iterator& rhs) { return lhs.m_Index != rhs.m_Index; }
+
+        friend std::tuple<Entity, Ts&...> operator*(const Iterator& it) { return it.get(); }
+
+    private:
+        const Query* m_Query;
+        size_t       m_Index;
+    };
+
+public:
+    /**
+     * @brief Subscribes to the manager's component events and collects the already matching entities.
+     */
+    explicit Query(EntityManager& manager);
+
+    Query(const Query& other)            = delete;
+    Query& operator=(const Query& other) = delete;
+
+    Iterator begin() const;
+    Iterator end() const;
+
+    size_t size() const;
+    bool   contains(EntityId id) const;
+
+    /**
+     * @return Contiguous array of size() member ids.
+     */
+    const EntityId* getEntities() const;
+
+    EntityManager& getEntityManager() const;
+
+private:
+    static constexpr uint32_t INVALID_POSITION = UINT32_MAX;
+
+    bool matches(const ComponentSignature& signature) const;
+    void insert(EntityId id);
+    void erase(EntityId id);
+
+    template<typename T>
+    void subscribeIncluded();
+
+    template<typename T>
+    void subscribeExcluded();
+
+    template<typename T>
+    void onIncludedConstruct(const EventComponentConstruct<T>& event);
+
+    template<typename T>
+    void onIncludedRemove(const EventComponentRemove<T>& event);
+
+    template<typename T>
+    void onIncludedRemoveBatch(const EventComponentRemoveBatch<T>& event);
+
+    template<typename T>
+    void onExcludedConstruct(const EventComponentConstruct<T>& event);
+
+    template<typename T>
+    void onExcludedRemove(const EventComponentRemove<T>& event);
+
+private:
+    std::tuple<ComponentPool<std::remove_const_t<Ts>>*...> m_Pools;
+    ComponentSignature                                     m_Mask;
+    ComponentSignature                                     m_ExcludedMask;
+    EntityManager*                                         m_EntityManager;
+    std::vector<ScopedConnection>                          m_Connections;
+
+    /* Dense array of members and every member's position in it, indexed by entity's slot index */
+    std::vector<EntityId> m_Members;
+    std::vector<uint32_t> m_Positions;
+};
+
+} // namespace gwars
+
+#include "ecs/query.ipp"
@@ -0,0 +1,241 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file query.ipp
+ * @date 2026-10-16
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cassert>
+
+namespace gwars {
+
+template<typename... Excluded, typename... Ts>
+Query<Exclude<Excluded...>, Ts...>::Iterator::Iterator(const Query& query, size_t index)
+    : m_Query(&query), m_Index(index)
+{
+}
+
+template<typename... Excluded, typename... Ts>
+typename Query<Exclude<Excluded...>, Ts...>::Iterator& Query<Exclude<Excluded...>, Ts...>::Iterator::operator++()
+{
+    ++m_Index;
+    return *this;
+}
+
+template<typename... Excluded, typename... Ts>
+typename Query<Exclude<Excluded...>, Ts...>::Iterator Query<Exclude<Excluded...>, Ts...>::Iterator::operator++(int)
+{
+    Iterator temp{*this};
+    ++(*this);
+    return temp;
+}
+
+template<typename... Excluded, typename... Ts>
+Entity Query<Exclude<Excluded...>, Ts...>::Iterator::getEntity() const
+{
+    return Entity{m_Query->m_Members[m_Index], *m_Query->m_EntityManager};
+}
+
+template<typename... Excluded, typename... Ts>
+std::tuple<Entity, Ts&...> Query<Exclude<Excluded...>, Ts...>::Iterator::get() const
+{
+    EntityId id = m_Query->m_Members[m_Index];
+    return std::tuple<Entity, Ts&...>(
+        Entity{id, *m_Query->m_EntityManager},
+        accessComponent<Ts>(*std::get<ComponentPool<std::remove_const_t<Ts>>*>(m_Query->m_Pools), id)...);
+}
+
+template<typename... Excluded, typename... Ts>
+Query<Exclude<Excluded...>, Ts...>::Query(EntityManager& manager)
+    : m_Pools(&manager.getPool<std::remove_const_t<Ts>>()...),
+      m_Mask(ComponentSignature::create<Ts...>()),
+      m_ExcludedMask(ComponentSignature::create<Excluded...>()),
+      m_EntityManager(&manager)
+{
+    m_Connections.reserve(3 * sizeof...(Ts) + 2 * sizeof...(Excluded));
+
+    (subscribeIncluded<std::remove_const_t<Ts>>(), ...);
+    (subscribeExcluded<std::remove_const_t<Excluded>>(), ...);
+
+    EntityView<Exclude<Excluded...>, const std::remove_const_t<Ts>...> view{manager};
+    m_Members.reserve(view.sizeHint());
+
+    for (auto it = view.begin(); it != view.end(); ++it)
+    {
+        insert(it.getEntity().getId());
+    }
+}
+
+template<typename... Excluded, typename... Ts>
+typename Query<Exclude<Excluded...>, Ts...>::Iterator Query<Exclude<Excluded...>, Ts...>::begin() const
+{
+    return Iterator{*this, 0};
+}
+
+template<typename... Excluded, typename... Ts>
+typename Query<Exclude<Excluded...>, Ts...>::Iterator Query<Exclude<Excluded...>, Ts...>::end() const
+{
+    return Iterator{*this, m_Members.size()};
+}
+
+template<typename... Excluded, typename... Ts>
+size_t Query<Exclude<Excluded...>, Ts...>::size() const
+{
+    return m_Members.size();
+}
+
+template<typename... Excluded, typename... Ts>
+bool Query<Exclude<Excluded...>, Ts...>::contains(EntityId id) const
+{
+    uint32_t index = getEntityIndex(id);
+    return index < m_Positions.size() && m_Positions[index] != INVALID_POSITION
+           && m_Members[m_Positions[index]] == id;
+}
+
+template<typename... Excluded, typename... Ts>
+const EntityId* Query<Exclude<Excluded...>, Ts...>::getEntities() const
+{
+    return m_Members.data();
+}
+
+template<typename... Excluded, typename... Ts>
+EntityManager& Query<Exclude<Excluded...>, Ts...>::getEntityManager() const
+{
+    return *m_EntityManager;
+}
+
+template<typename... Excluded, typename... Ts>
+bool Query<Exclude<Excluded...>, Ts...>::matches(const ComponentSignature& signature) const
+{
+    return signature.contains(m_Mask) && !signature.intersects(m_ExcludedMask);
+}
+
+template<typename... Excluded, typename... Ts>
+void Query<Exclude<Excluded...>, Ts...>::insert(EntityId id)
+{
+    if (contains(id))
+    {
+        return;
+    }
+
+    uint32_t index = getEntityIndex(id);
+    if (index >= m_Positions.size())
+    {
+        m_Positions.resize(index + 1, INVALID_POSITION);
+    }
+
+    m_Positions[index] = static_cast<uint32_t>(m_Members.size());
+    m_Members.push_back(id);
+}
+
+template<typename... Excluded, typename... Ts>
+void Query<Exclude<Excluded...>, Ts...>::erase(EntityId id)
+{
+    if (!contains(id))
+    {
+        return;
+    }
+
+    /* Swap-and-pop, same as in SparseSet */
+    uint32_t position = m_Positions[getEntityIndex(id)];
+    EntityId last     = m_Members.back();
+
+    m_Members[position]               = last;
+    m_Positions[getEntityIndex(last)] = position;
+    m_Positions[getEntityIndex(id)]   = INVALID_POSITION;
+    m_Members.pop_back();
+}
+
+template<typename... Excluded, typename... Ts>
+template<typename T>
+void Query<Exclude<Excluded...>, Ts...>::subscribeIncluded()
+{
+    m_Connections.emplace_back(
+        m_EntityManager->onConstruct<T>().template addHandler<&Query::onIncludedConstruct<T>>(*this));
+    m_Connections.emplace_back(m_EntityManager->onRemove<T>().template addHandler<&Query::onIncludedRemove<T>>(*this));
+    m_Connections.emplace_back(
+        m_EntityManager->onRemoveBatch<T>().template addHandler<&Query::onIncludedRemoveBatch<T>>(*this));
+}
+
+/* Batch removal destroys whole entities, so excluded components going away in a batch never add members */
+template<typename... Excluded, typename... Ts>
+template<typename T>
+void Query<Exclude<Excluded...>, Ts...>::subscribeExcluded()
+{
+    m_Connections.emplace_back(
+        m_EntityManager->onConstruct<T>().template addHandler<&Query::onExcludedConstruct<T>>(*this));
+    m_Connections.emplace_back(m_EntityManager->onRemove<T>().template addHandler<&Query::onExcludedRemove<T>>(*this));
+}
+
+/* Construct events are fired after the component has been added to the signature, remove events before
+ * it has been removed from it */
+template<typename... Excluded, typename... Ts>
+template<typename T>
+void Query<Exclude<Excluded...>, Ts...>::onIncludedConstruct(const EventComponentConstruct<T>& event)
+{
+    if (matches(m_EntityManager->getSignature(event.entityId)))
+    {
+        insert(event.entityId);
+    }
+}
+
+template<typename... Excluded, typename... Ts>
+template<typename T>
+void Query<Exclude<Excluded...>, Ts...>::onIncludedRemove(const EventComponentRemove<T>& event)
+{
+    erase(event.entityId);
+}
+
+template<typename... Excluded, typename... Ts>
+template<typename T>
+void Query<Exclude<Excluded...>, Ts...>::onIncludedRemoveBatch(const EventComponentRemoveBatch<T>& event)
+{
+    for (size_t i = 0; i < event.count; ++i)
+    {
+        erase(event.entities[i]);
+    }
+}
+
+template<typename... Excluded, typename... Ts>
+template<typename T>
+void Query<Exclude<Excluded...>, Ts...>::onExcludedConstruct(const EventComponentConstruct<T>& event)
+{
+    erase(event.entityId);
+}
+
+template<typename... Excluded, typename... Ts>
+template<typename T>
+void Query<Exclude<Excluded...>, Ts...>::onExcludedRemove(const EventComponentRemove<T>& event)
+{
+    ComponentSignature signature = m_EntityManager->getSignature(event.entityId);
+    signature.reset(ComponentType<T>::getId());
+
+    if (matches(signature))
+    {
+        insert(event.entityId);
+    }
+}
+
+} // namespace gwars
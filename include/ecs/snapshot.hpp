@@ -0,0 +1,81 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file snapshot.hpp
+ * @date 2026-10-16
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+
+#include "ecs/entity_manager.hpp"
+#include "utils/binary_stream.hpp"
+
+namespace gwars {
+
+/**
+ * Component pools are stored as the number of components followed by the block of entity ids and
+ * then either the block of components (trivially copyable components) or one record per component
+ * written by a save hook. Entity slots must be saved and loaded before pools, see
+ * EntityManager::saveEntities.
+ */
+
+/**
+ * @brief Writes the pool of trivially copyable components T as whole memory blocks.
+ */
+template<typename T>
+void savePool(EntityManager& manager, BinaryWriter& writer);
+
+/**
+ * @param saveComponent Called as saveComponent(BinaryWriter& writer, const T& component) for every
+ *                      component.
+ */
+template<typename T, typename SaveFunction>
+void savePool(EntityManager& manager, BinaryWriter& writer, SaveFunction&& saveComponent);
+
+/**
+ * @brief Reads the pool written by savePool<T>(manager, writer). Components are copied in a single
+ *        block, construct events are fired only if there are handlers for them.
+ *
+ * @return Whether the data has been read successfully. Fails without loading anything if an entity
+ *         isn't alive or is listed twice.
+ */
+template<typename T>
+bool loadPool(EntityManager& manager, BinaryReader& reader);
+
+/**
+ * @brief Reads the pool written with a save hook. Components are created one by one with
+ *        EntityManager::createComponent, so construct events are fired.
+ *
+ * @param loadComponent Called as loadComponent(BinaryReader& reader, T& component) for every
+ *                      default-constructed component, returns whether the component has been loaded.
+ *
+ * @return Whether the data has been read successfully. Stops at the first entity, which isn't alive
+ *         or already has the component, components loaded before it are kept.
+ */
+template<typename T, typename LoadFunction>
+bool loadPool(EntityManager& manager, BinaryReader& reader, LoadFunction&& loadComponent);
+
+} // namespace gwars
+
+#include "ecs/snapshot.ipp"
@@ -0,0 +1,131 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file snapshot.ipp
+ * @date 2026-10-16
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <type_traits>
+#include <vector>
+
+namespace gwars {
+
+template<typename T>
+void savePool(EntityManager& manager, BinaryWriter& writer)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Components without a save hook must be trivially copyable");
+
+    const ComponentPool<T>& pool = manager.getPool<T>();
+
+    writer.writeValue<uint64_t>(pool.size());
+    writer.writeBlock(pool.getEntities(), pool.size() * sizeof(EntityId), alignof(EntityId));
+    writer.writeBlock(pool.getComponents(), pool.size() * sizeof(T), alignof(T));
+}
+
+template<typename T, typename SaveFunction>
+void savePool(EntityManager& manager, BinaryWriter& writer, SaveFunction&& saveComponent)
+{
+    const ComponentPool<T>& pool = manager.getPool<T>();
+
+    writer.writeValue<uint64_t>(pool.size());
+    writer.writeBlock(pool.getEntities(), pool.size() * sizeof(EntityId), alignof(EntityId));
+
+    for (size_t i = 0; i < pool.size(); ++i)
+    {
+        saveComponent(writer, pool.getComponents()[i]);
+    }
+}
+
+template<typename T>
+bool loadPool(EntityManager& manager, BinaryReader& reader)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Components without a load hook must be trivially copyable");
+
+    uint64_t        count    = reader.readValue<uint64_t>();
+    const EntityId* entities = static_cast<const EntityId*>(
+        reader.readArray(count, sizeof(EntityId), alignof(EntityId)));
+    const T* components = static_cast<const T*>(reader.readArray(count, sizeof(T), alignof(T)));
+
+    if (reader.isFailed())
+    {
+        return false;
+    }
+
+    /* A repeated entity would break the pool's sparse-to-dense mapping */
+    std::vector<bool> loaded;
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        if (!manager.isAlive(entities[i]))
+        {
+            return false;
+        }
+
+        const uint32_t index = getEntityIndex(entities[i]);
+        if (index >= loaded.size())
+        {
+            loaded.resize(index + 1, false);
+        }
+
+        if (loaded[index])
+        {
+            return false;
+        }
+
+        loaded[index] = true;
+    }
+
+    manager.getPool<T>().assign(entities, components, count);
+    return true;
+}
+
+template<typename T, typename LoadFunction>
+bool loadPool(EntityManager& manager, BinaryReader& reader, LoadFunction&& loadComponent)
+{
+    uint64_t        count    = reader.readValue<uint64_t>();
+    const EntityId* entities = static_cast<const EntityId*>(
+        reader.readArray(count, sizeof(EntityId), alignof(EntityId)));
+
+    if (reader.isFailed())
+    {
+        return false;
+    }
+
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        T component;
+        if (!loadComponent(reader, component) || reader.isFailed() || !manager.isAlive(entities[i])
+            || manager.hasComponent<T>(entities[i]))
+        {
+            return false;
+        }
+
+        manager.createComponent<T>(entities[i], std::move(component));
+    }
+
+    return true;
+}
+
+} // namespace gwars
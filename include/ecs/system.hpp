@@ -0,0 +1,105 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file system.hpp
+ * @date 2026-10-16
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+
+#include "ecs/component_type.hpp"
+#include "ecs/entity_manager.hpp"
+#include <vector>
+
+namespace gwars {
+
+/**
+ * @brief Set of component types a system reads and writes, which tells the scheduler which systems
+ *        may run concurrently.
+ */
+class SystemAccess
+{
+public:
+    template<typename... Ts>
+    SystemAccess& read();
+
+    template<typename... Ts>
+    SystemAccess& write();
+
+    /**
+     * @brief Marks the system as one, which may touch anything (e.g. run scripts, fire events or make
+     *        structural changes). Such systems run alone on the thread calling the scheduler.
+     */
+    SystemAccess& exclusive();
+
+    bool isExclusive() const;
+
+    /**
+     * @return Whether the two systems can't run concurrently, i.e. one of them writes a component the
+     *         other one reads or writes.
+     */
+    bool conflictsWith(const SystemAccess& other) const;
+
+    /**
+     * @brief Creates pools of all declared components, so that concurrently running systems never
+     *        create pools.
+     */
+    void createPools(EntityManager& manager) const;
+
+private:
+    using CreatePoolFunction = void (*)(EntityManager& manager);
+
+    template<typename T>
+    void add(std::vector<ComponentTypeId>& typeIds);
+
+    static bool intersect(const std::vector<ComponentTypeId>& first, const std::vector<ComponentTypeId>& second);
+
+private:
+    std::vector<ComponentTypeId>    m_Reads;
+    std::vector<ComponentTypeId>    m_Writes;
+    std::vector<CreatePoolFunction> m_CreatePoolFunctions;
+    bool                            m_Exclusive{false};
+};
+
+class ISystem
+{
+public:
+    virtual ~ISystem() = default;
+
+    /**
+     * @brief Called once when the system is added to a scheduler.
+     */
+    virtual void declareAccess(SystemAccess& access) const = 0;
+
+    /**
+     * @warning Unless the system is exclusive, it may be called from a worker thread, so it must only
+     *          touch the declared components. Structural changes have to be recorded into the calling
+     *          thread's command buffer.
+     */
+    virtual void onUpdate(float dt) = 0;
+};
+
+} // namespace gwars
+
+#include "ecs/system.ipp"
@@ -0,0 +1,61 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file system.ipp
+ * @date 2026-10-16
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <algorithm>
+
+namespace gwars {
+
+template<typename... Ts>
+SystemAccess& SystemAccess::read()
+{
+    (add<Ts>(m_Reads), ...);
+    return *this;
+}
+
+template<typename... Ts>
+SystemAccess& SystemAccess::write()
+{
+    (add<Ts>(m_Writes), ...);
+    return *this;
+}
+
+template<typename T>
+void SystemAccess::add(std::vector<ComponentTypeId>& typeIds)
+{
+    const ComponentTypeId typeId = ComponentType<T>::getId();
+
+    if (std::find(typeIds.begin(), typeIds.end(), typeId) == typeIds.end())
+    {
+        typeIds.push_back(typeId);
+        m_CreatePoolFunctions.push_back([](EntityManager& manager) { manager.getPool<T>(); });
+    }
+}
+
+} // namespace gwars
@@ -0,0 +1,93 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file system_scheduler.hpp
+ * @date 2026-10-16
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+
+#include "ecs/system.hpp"
+#include "utils/thread_pool.hpp"
+#include <atomic>
+
+namespace gwars {
+
+/**
+ * @brief Runs systems in the order they were added, letting non-conflicting ones run concurrently.
+ *
+ * Every system depends on all earlier added systems it conflicts with (see SystemAccess). Exclusive
+ * systems split the systems into segments, each of which is run as a dependency graph on the worker
+ * pool, while exclusive systems themselves run on the calling thread in between.
+ */
+class SystemScheduler
+{
+public:
+    SystemScheduler(EntityManager& manager, size_t threadsCount = ThreadPool::getDefaultThreadsCount());
+    ~SystemScheduler();
+
+    SystemScheduler(const SystemScheduler& other)            = delete;
+    SystemScheduler& operator=(const SystemScheduler& other) = delete;
+
+    /**
+     * @brief Takes ownership of the system.
+     */
+    void addSystem(ISystem* system);
+
+    /**
+     * @brief Runs all systems once and returns after every one of them has finished.
+     */
+    void run(float dt);
+
+private:
+    struct Node
+    {
+        SystemScheduler*      scheduler{nullptr};
+        ISystem*              system{nullptr};
+        SystemAccess          access;
+        std::vector<size_t>   dependents;
+        uint32_t              dependenciesCount{0};
+        std::atomic<uint32_t> remainingDependencies{0};
+    };
+
+    void buildGraph();
+    void runSegment(size_t begin, size_t end, float dt);
+
+    static void runNode(void* data);
+
+private:
+    EntityManager&     m_Manager;
+    std::vector<Node*> m_Nodes;
+    bool               m_GraphBuilt{false};
+
+    float                   m_DeltaTime{0};
+    std::atomic<size_t>     m_PendingCount{0};
+    std::mutex              m_Mutex;
+    std::condition_variable m_SegmentFinished;
+
+    /* Declared last, so that the workers are joined before anything they use is destroyed */
+    ThreadPool m_ThreadPool;
+};
+
+} // namespace gwars
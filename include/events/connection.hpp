@@ -0,0 +1,106 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file connection.hpp
+ * @date 2026-10-17
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <stdint.h>
+
+namespace gwars {
+
+/**
+ * @brief Handler slot index (lower half) and the slot's generation (upper half), see HandlerList.
+ */
+using HandlerId = uint64_t;
+
+class IHandlerList
+{
+public:
+    virtual ~IHandlerList() = default;
+
+    /**
+     * @brief Removes the handler, does nothing if it has already been removed.
+     */
+    virtual void remove(HandlerId handlerId) = 0;
+};
+
+/**
+ * @brief Handle to a subscribed handler, which removes it in O(1) without searching for the delegate.
+ *
+ * Connections are move-only and reset on disconnect(). Disconnecting a handler, which has already been
+ * removed in some other way, is a no-op, as the id's generation no longer matches. The sink must outlive
+ * the connection.
+ */
+class Connection
+{
+public:
+    Connection() = default;
+    Connection(IHandlerList* list, HandlerId handlerId);
+
+    Connection(const Connection& other)            = delete;
+    Connection& operator=(const Connection& other) = delete;
+
+    Connection(Connection&& other);
+    Connection& operator=(Connection&& other);
+
+    void disconnect();
+    bool isConnected() const;
+
+private:
+    IHandlerList* m_List{nullptr};
+    HandlerId     m_HandlerId{0};
+};
+
+/**
+ * @brief Disconnects the connection on destruction or on assigning another connection.
+ */
+class ScopedConnection
+{
+public:
+    ScopedConnection() = default;
+    ScopedConnection(Connection&& connection);
+    ~ScopedConnection();
+
+    ScopedConnection(const ScopedConnection& other)            = delete;
+    ScopedConnection& operator=(const ScopedConnection& other) = delete;
+
+    ScopedConnection(ScopedConnection&& other);
+    ScopedConnection& operator=(ScopedConnection&& other);
+
+    void disconnect();
+    bool isConnected() const;
+
+    /**
+     * @brief Stops managing the connection without disconnecting it.
+     */
+    Connection release();
+
+private:
+    Connection m_Connection;
+};
+
+} // namespace gwars
@@ -0,0 +1,84 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file delegate.hpp
+ * @date 2026-10-16
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <utility>
+
+namespace gwars {
+
+template<typename Signature>
+class Delegate;
+
+/**
+ * @brief Non-owning reference to a member function bound to an object or to a free function.
+ *
+ * Stores just the object pointer and a pointer to a trampoline generated for the bound function, so
+ * creating, copying and calling a delegate never allocates memory. Delegates are equal if they are bound
+ * to the same function and object, which lets handlers be found for removal.
+ */
+template<typename R, typename... Args>
+class Delegate<R(Args...)>
+{
+public:
+    Delegate() = default;
+
+    template<auto MethodT, class ClassT>
+    static Delegate fromMethod(ClassT& instance);
+
+    template<auto FunctionT>
+    static Delegate fromFunction();
+
+    R operator()(Args... args) const;
+
+    /**
+     * @return Whether the delegate is bound to a function.
+     */
+    explicit operator bool() const;
+
+    bool operator==(const Delegate& other) const;
+    bool operator!=(const Delegate& other) const;
+
+private:
+    using Trampoline = R (*)(void*, Args...);
+
+    Delegate(void* instance, Trampoline trampoline);
+
+    template<auto MethodT, class ClassT>
+    static R callMethod(void* instance, Args... args);
+
+    template<auto FunctionT>
+    static R callFunction(void* instance, Args... args);
+
+private:
+    void*      m_Instance{nullptr};
+    Trampoline m_Trampoline{nullptr};
+};
+
+} // namespace gwars
+
+#include "events/delegate.ipp"
@@ -0,0 +1,92 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file delegate.ipp
+ * @date 2026-10-16
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cassert>
+
+namespace gwars {
+
+template<typename R, typename... Args>
+Delegate<R(Args...)>::Delegate(void* instance, Trampoline trampoline) : m_Instance(instance), m_Trampoline(trampoline)
+{
+}
+
+template<typename R, typename... Args>
+template<auto MethodT, class ClassT>
+Delegate<R(Args...)> Delegate<R(Args...)>::fromMethod(ClassT& instance)
+{
+    return Delegate{const_cast<void*>(static_cast<const void*>(&instance)), &callMethod<MethodT, ClassT>};
+}
+
+template<typename R, typename... Args>
+template<auto FunctionT>
+Delegate<R(Args...)> Delegate<R(Args...)>::fromFunction()
+{
+    return Delegate{nullptr, &callFunction<FunctionT>};
+}
+
+template<typename R, typename... Args>
+R Delegate<R(Args...)>::operator()(Args... args) const
+{
+    assert(m_Trampoline != nullptr);
+    return m_Trampoline(m_Instance, std::forward<Args>(args)...);
+}
+
+template<typename R, typename... Args>
+Delegate<R(Args...)>::operator bool() const
+{
+    return m_Trampoline != nullptr;
+}
+
+template<typename R, typename... Args>
+bool Delegate<R(Args...)>::operator==(const Delegate& other) const
+{
+    return m_Instance == other.m_Instance && m_Trampoline == other.m_Trampoline;
+}
+
+template<typename R, typename... Args>
+bool Delegate<R(Args...)>::operator!=(const Delegate& other) const
+{
+    return !(*this == other);
+}
+
+template<typename R, typename... Args>
+template<auto MethodT, class ClassT>
+R Delegate<R(Args...)>::callMethod(void* instance, Args... args)
+{
+    return (static_cast<ClassT*>(instance)->*MethodT)(std::forward<Args>(args)...);
+}
+
+template<typename R, typename... Args>
+template<auto FunctionT>
+R Delegate<R(Args...)>::callFunction(void*, Args... args)
+{
+    return FunctionT(std::forward<Args>(args)...);
+}
+
+} // namespace gwars
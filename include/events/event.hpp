@@ -29,7 +29,6 @@
 
 #include <functional>
 #include <stdint.h>
-#include <unordered_map>
 #include <vector>
 
 namespace gwars {
@@ -37,11 +36,23 @@ namespace gwars {
 using EventType                    = uint64_t;
 const EventType INVALID_EVENT_TYPE = 0;
 
+/**
+ * @brief Routes events to the handlers subscribed with EventSink::addKeyedHandler. Event types support
+ *        keyed handlers by defining `size_t getRoutingKeys(EventKey* keys) const`, which writes at most
+ *        MAX_EVENT_ROUTING_KEYS keys and returns their number.
+ */
+using EventKey                         = uint64_t;
+constexpr size_t MAX_EVENT_ROUTING_KEYS = 4;
+
 struct StaticEventTypeGenerator
 {
     static EventType nextEventType();
 };
 
+/**
+ * @brief Assigns every event type a small dense id on first use, so that EventDispatcher can store
+ *        sinks in a flat array indexed by the type.
+ */
 template<typename T>
 struct StaticEventTypeHolder
 {
@@ -42,8 +42,66 @@ public:
     template<typename T, typename... Args>
     void fireEvent(Args&&... args);
 
+    /**
+     * @brief Queues the event until the next dispatchQueued() instead of firing it right away, so that
+     *        handlers don't run in the middle of the sender's work.
+     */
+    template<typename T, typename... Args>
+    void enqueueEvent(Args&&... args);
+
+    /**
+     * @brief Lets threads post events of the type, must be called on the main thread.
+     *
+     * @param capacity Maximum number of events posted between two dispatchQueued() calls.
+     *
+     * @return Sink to post to with EventSink::postEvent. It stays valid as long as the dispatcher, so
+     *         threads keep the reference instead of calling getSink(), which isn't thread-safe.
+     */
+    template<typename T>
+    EventSink<T>& enablePosting(size_t capacity);
+
+    /**
+     * @brief Sync point, which fires all queued events. Events posted from other threads are queued
+     *        first, in the order of enablePosting() calls. Event types are dispatched in the order of
+     *        their first enqueued event, events of the same type in the order they have been enqueued.
+     *        Events enqueued by handlers are dispatched within the same call.
+     */
+    void dispatchQueued();
+
+    /**
+     * @return Number of event types, which sinks have been created for.
+     */
+    size_t getSinksCount() const;
+
+    /**
+     * @return Total number of handlers subscribed to all of the sinks.
+     */
+    size_t getHandlersCount() const;
+
+    /**
+     * @brief Prints call counts and timings of every handler sorted by the total time. Does nothing
+     *        unless the project is built with GWARS_EVENT_PROFILING.
+     */
+    void printProfile() const;
+
+    /**
+     * @brief Resets the counters printProfile reports.
+     */
+    void resetProfile();
+
 private:
-    std::unordered_map<EventType, IEventSink*> m_Sinks;
+    template<typename T>
+    EventSink<T>& createSink(EventType type);
+
+private:
+    /* Indexed by EventType, sinks are created lazily */
+    std::vector<IEventSink*> m_Sinks;
+
+    /* Sinks waiting for dispatchQueued in the order of their first enqueued event */
+    std::vector<IEventSink*> m_QueuedSinks;
+
+    /* Sinks, which can be posted to, in the order of enablePosting calls */
+    std::vector<IEventSink*> m_PostingSinks;
 };
 
 } // namespace gwars
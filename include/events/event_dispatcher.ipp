@@ -36,16 +36,27 @@ EventSink<T>& EventDispatcher::getSink()
 {
     const EventType type = StaticEventTypeHolder<T>::getType();
 
-    IEventSink* sink = nullptr;
-    if (m_Sinks.find(type) == m_Sinks.end())
+    /* Hot path is a bounds check and an indexed load, creation is kept out of line */
+    if (type < m_Sinks.size() && m_Sinks[type] != nullptr)
     {
-        m_Sinks[type] = new EventSink<T>();
+        return *static_cast<EventSink<T>*>(m_Sinks[type]);
     }
 
-    sink = m_Sinks[type];
+    return createSink<T>(type);
+}
 
-    assert(sink != nullptr);
-    return dynamic_cast<EventSink<T>&>(*sink);
+template<typename T>
+EventSink<T>& EventDispatcher::createSink(EventType type)
+{
+    if (type >= m_Sinks.size())
+    {
+        m_Sinks.resize(type + 1, nullptr);
+    }
+
+    EventSink<T>* sink = new EventSink<T>();
+    m_Sinks[type]      = sink;
+
+    return *sink;
 }
 
 template<typename T, typename... Args>
@@ -55,4 +66,24 @@ void EventDispatcher::fireEvent(Args&&... args)
     getSink<T>().fireEvent(event);
 }
 
+template<typename T, typename... Args>
+void EventDispatcher::enqueueEvent(Args&&... args)
+{
+    EventSink<T>& sink = getSink<T>();
+    if (sink.enqueueEvent(T(std::forward<Args>(args)...)))
+    {
+        m_QueuedSinks.push_back(&sink);
+    }
+}
+
+template<typename T>
+EventSink<T>& EventDispatcher::enablePosting(size_t capacity)
+{
+    EventSink<T>& sink = getSink<T>();
+    sink.enablePosting(capacity);
+    m_PostingSinks.push_back(&sink);
+
+    return sink;
+}
+
 } // namespace gwars
\ No newline at end of file
@@ -0,0 +1,76 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file event_profiling.hpp
+ * @date 2026-10-17
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+
+#ifdef GWARS_EVENT_PROFILING
+
+#include <chrono>
+#include <stdint.h>
+
+namespace gwars {
+
+/**
+ * @brief Timings of a single handler subscribed to an event sink, recorded only if the project is built
+ *        with GWARS_EVENT_PROFILING.
+ */
+struct EventHandlerProfile
+{
+    const char* eventTypeName{nullptr}; ///< Mangled, see std::type_info::name
+    const char* handlerName{nullptr};   ///< __PRETTY_FUNCTION__ of getHandlerName
+    size_t      handlersCount{0};       ///< Handlers subscribed to the same sink
+    uint64_t    firedCount{0};          ///< Events fired by the sink
+    uint64_t    callsCount{0};
+    uint64_t    totalNanoseconds{0};
+    uint64_t    maxNanoseconds{0};
+};
+
+/**
+ * @return String containing the handler's name, which is formatted by EventDispatcher::printProfile.
+ */
+template<auto HandlerT>
+const char* getHandlerName()
+{
+    return __PRETTY_FUNCTION__;
+}
+
+using EventProfilingClock = std::chrono::steady_clock;
+
+inline void recordHandlerCall(EventHandlerProfile& profile, EventProfilingClock::time_point start)
+{
+    uint64_t nanoseconds = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(EventProfilingClock::now() - start).count());
+
+    ++profile.callsCount;
+    profile.totalNanoseconds += nanoseconds;
+    profile.maxNanoseconds = nanoseconds > profile.maxNanoseconds ? nanoseconds : profile.maxNanoseconds;
+}
+
+} // namespace gwars
+
+#endif
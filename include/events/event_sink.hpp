@@ -27,84 +27,181 @@
 
 #pragma once
 
+#include "events/delegate.hpp"
 #include "events/event.hpp"
+#include "events/event_profiling.hpp"
+#include "events/handler_list.hpp"
+#include "utils/mpsc_queue.hpp"
+#include "utils/span.hpp"
+#include <unordered_map>
 
 namespace gwars {
 
-struct StaticEventHandlerDelegateIdGenerator
-{
-    static uint64_t nextId();
-};
-
-template<auto T>
-struct StaticEventHandlerDelegateId
-{
-public:
-    static uint64_t getId();
-
-private:
-    static uint64_t s_Id;
-};
-
 class IEventSink
 {
 public:
     virtual ~IEventSink() = default;
+
+    virtual size_t getHandlersCount() const = 0;
+
+    /**
+     * @brief Fires the events queued so far in the order they have been enqueued.
+     */
+    virtual void dispatchQueued() = 0;
+
+    /**
+     * @brief Moves the events posted from other threads to the queue in the order they have been posted.
+     *
+     * @return Whether the sink hasn't been waiting for dispatch before and some events have been moved.
+     */
+    virtual bool drainPosted() = 0;
+
+#ifdef GWARS_EVENT_PROFILING
+    /**
+     * @brief Appends a profile for every handler of the sink.
+     */
+    virtual void collectProfile(std::vector<EventHandlerProfile>& profiles) const = 0;
+    virtual void resetProfile()                                                   = 0;
+#endif
 };
 
 template<typename T>
 class EventSink : public IEventSink
 {
 public:
-    using EventHandlerT = void(const T&);
+    using EventHandlerT      = void(const T&);
+    using BatchEventHandlerT = void(Span<const T>);
 
     /**
-     * @warning Currently adding several same handlers (with the same method and instance)
-     * causes undefined behavior.
+     * @brief Handlers can be added and removed at any time, including from other handlers of the sink.
+     *        Handlers added during dispatch are called starting from the next event.
      *
-     * @tparam HandlerMethodT
-     * @tparam HandlerClassT
-     * @param handler
+     * @return Connection, which removes the handler in O(1), see ScopedConnection.
      */
     template<auto HandlerMethodT, class HandlerClassT>
-    void addHandler(HandlerClassT& handler);
+    Connection addHandler(HandlerClassT& handler);
 
-    /**
-     * @warning Currently adding several same handlers causes undefined behavior.
-     *
-     * @tparam HandlerMethodT
-     * @tparam HandlerClassT
-     * @param handler
-     */
     template<auto HandlerFunctionT>
-    void addHandler();
+    Connection addHandler();
 
+    /**
+     * @brief Removes the handler by searching for it in O(n), prefer disconnecting the Connection.
+     */
     template<auto HandlerMethodT, class HandlerClassT>
     void removeHandler(HandlerClassT& handler);
 
     template<auto HandlerFunctionT>
     void removeHandler();
 
+    /**
+     * @brief Adds a handler, which receives all queued events of the type at once on dispatchQueued(),
+     *        after the per-event handlers have been called. Events fired immediately are passed as a
+     *        single-element span.
+     */
+    template<auto HandlerMethodT, class HandlerClassT>
+    Connection addBatchHandler(HandlerClassT& handler);
+
+    template<auto HandlerFunctionT>
+    Connection addBatchHandler();
+
+    template<auto HandlerMethodT, class HandlerClassT>
+    void removeBatchHandler(HandlerClassT& handler);
+
+    template<auto HandlerFunctionT>
+    void removeBatchHandler();
+
+    /**
+     * @brief Adds a handler, which is called only for the events having the key among their routing keys,
+     *        see EventKey. Handlers are found by a single table lookup per key, so subscribing many
+     *        objects to their own keys doesn't slow down the dispatch of unrelated events.
+     */
+    template<auto HandlerMethodT, class HandlerClassT>
+    Connection addKeyedHandler(EventKey key, HandlerClassT& handler);
+
+    template<auto HandlerFunctionT>
+    Connection addKeyedHandler(EventKey key);
+
+    template<auto HandlerMethodT, class HandlerClassT>
+    void removeKeyedHandler(EventKey key, HandlerClassT& handler);
+
+    template<auto HandlerFunctionT>
+    void removeKeyedHandler(EventKey key);
+
     void fireEvent(const T& event);
 
+    /**
+     * @return Whether firing an event would call anything, lets senders skip building events nobody listens to.
+     *         Conservatively true while keyed handler lists exist, empty ones are released after dispatch.
+     */
+    bool hasHandlers() const;
+
+    size_t getHandlersCount() const override;
+
+    /**
+     * @brief Stores a copy of the event, which is fired on the next dispatchQueued(). Queue buffers keep
+     *        their capacity, so enqueueing doesn't allocate once the peak number of events is reached.
+     *
+     * @return Whether the sink hasn't been waiting for dispatch before, see EventDispatcher::enqueueEvent.
+     */
+    bool enqueueEvent(const T& event);
+
+    void dispatchQueued() override;
+
+    /**
+     * @brief Creates the queue for postEvent(), must be called on the main thread before any thread posts.
+     */
+    void enablePosting(size_t capacity);
+
+    /**
+     * @brief Thread-safe and lock-free version of enqueueEvent(), the event becomes queued on the main
+     *        thread's next drainPosted(). Never blocks, see EventDispatcher::enablePosting.
+     *
+     * @return False if the posted queue is full and the event has been dropped.
+     */
+    bool postEvent(const T& event);
+
+    bool drainPosted() override;
+
+#ifdef GWARS_EVENT_PROFILING
+    void collectProfile(std::vector<EventHandlerProfile>& profiles) const override;
+    void resetProfile() override;
+#endif
+
 private:
-    struct HandlerDelegate
-    {
-        std::function<EventHandlerT> function;
-        uint64_t                     functionId{0};
-        void*                        handler{nullptr};
+    using HandlerDelegate      = Delegate<EventHandlerT>;
+    using BatchHandlerDelegate = Delegate<BatchEventHandlerT>;
+
+    template<auto HandlerT, typename DelegateT>
+    static Connection connect(HandlerList<DelegateT>& handlers, const DelegateT& delegate);
 
-        template<auto HandlerMethodT, class HandlerClassT>
-        static HandlerDelegate wrapMethod(HandlerClassT& handler);
+    using KeyedHandlerList = HandlerList<HandlerDelegate>;
 
-        template<auto HandlerFunctionT>
-        static HandlerDelegate wrapFunction();
+    KeyedHandlerList& getKeyedHandlers(EventKey key);
+    void              releaseEmptyKeyedHandlers();
 
-        bool operator==(const HandlerDelegate& delegate) const;
-    };
+    void callHandlers(const T& event);
+    void callKeyedHandlers(const T& event);
 
 private:
-    std::vector<HandlerDelegate> m_Handlers;
+    HandlerList<HandlerDelegate>      m_Handlers;
+    HandlerList<BatchHandlerDelegate> m_BatchHandlers;
+
+    /* Empty lists are moved to the free lists instead of being destroyed, so that connections to them and
+     * lists being called stay valid. Stale connections are ignored by the lists, see HandlerList::remove. */
+    std::unordered_map<EventKey, std::unique_ptr<KeyedHandlerList>> m_KeyedHandlers;
+    std::vector<std::unique_ptr<KeyedHandlerList>>                  m_FreeKeyedHandlers;
+    size_t                                                          m_KeyedHandlersReleaseSize{0};
+
+    /* Events enqueued by handlers during dispatch go to the other buffer */
+    std::vector<T> m_Queue;
+    std::vector<T> m_DispatchedQueue;
+    bool           m_Queued{false};
+
+    std::unique_ptr<MpscQueue<T>> m_PostedQueue;
+
+#ifdef GWARS_EVENT_PROFILING
+    uint64_t m_FiredCount{0};
+#endif
 };
 
 } // namespace gwars
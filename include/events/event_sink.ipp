@@ -27,94 +27,358 @@
 
 #pragma once
 
+#include <type_traits>
+
+#ifdef GWARS_EVENT_PROFILING
+#include <algorithm>
+#include <cstring>
+#include <typeinfo>
+#endif
+
 namespace gwars {
 
-template<auto T>
-uint64_t StaticEventHandlerDelegateId<T>::s_Id{StaticEventHandlerDelegateIdGenerator::nextId()};
+template<typename T, typename = void>
+struct HasRoutingKeys : std::false_type
+{
+};
+
+template<typename T>
+struct HasRoutingKeys<T, std::void_t<decltype(std::declval<const T&>().getRoutingKeys(std::declval<EventKey*>()))>>
+    : std::true_type
+{
+};
 
-template<auto T>
-uint64_t StaticEventHandlerDelegateId<T>::getId()
+template<typename T>
+template<auto HandlerMethodT, class HandlerClassT>
+Connection EventSink<T>::addHandler(HandlerClassT& handler)
 {
-    return s_Id;
+    return connect<HandlerMethodT>(m_Handlers, HandlerDelegate::template fromMethod<HandlerMethodT>(handler));
+}
+
+template<typename T>
+template<auto HandlerFunctionT>
+Connection EventSink<T>::addHandler()
+{
+    return connect<HandlerFunctionT>(m_Handlers, HandlerDelegate::template fromFunction<HandlerFunctionT>());
 }
 
 template<typename T>
 template<auto HandlerMethodT, class HandlerClassT>
-typename EventSink<T>::HandlerDelegate EventSink<T>::HandlerDelegate::wrapMethod(HandlerClassT& handler)
+void EventSink<T>::removeHandler(HandlerClassT& handler)
 {
-    return {std::bind(HandlerMethodT, &handler, std::placeholders::_1),
-            StaticEventHandlerDelegateId<HandlerMethodT>::getId(),
-            reinterpret_cast<void*>(&handler)};
+    m_Handlers.removeDelegate(HandlerDelegate::template fromMethod<HandlerMethodT>(handler));
 }
 
 template<typename T>
 template<auto HandlerFunctionT>
-typename EventSink<T>::HandlerDelegate EventSink<T>::HandlerDelegate::wrapFunction()
+void EventSink<T>::removeHandler()
 {
-    return {std::bind(HandlerFunctionT, std::placeholders::_1),
-            StaticEventHandlerDelegateId<HandlerFunctionT>::getId(),
-            nullptr};
+    m_Handlers.removeDelegate(HandlerDelegate::template fromFunction<HandlerFunctionT>());
 }
 
 template<typename T>
-bool EventSink<T>::HandlerDelegate::operator==(const HandlerDelegate& delegate) const
+template<auto HandlerMethodT, class HandlerClassT>
+Connection EventSink<T>::addBatchHandler(HandlerClassT& handler)
 {
-    return functionId == delegate.functionId && handler == delegate.handler;
+    return connect<HandlerMethodT>(m_BatchHandlers, BatchHandlerDelegate::template fromMethod<HandlerMethodT>(handler));
+}
+
+template<typename T>
+template<auto HandlerFunctionT>
+Connection EventSink<T>::addBatchHandler()
+{
+    return connect<HandlerFunctionT>(m_BatchHandlers, BatchHandlerDelegate::template fromFunction<HandlerFunctionT>());
 }
 
 template<typename T>
 template<auto HandlerMethodT, class HandlerClassT>
-void EventSink<T>::addHandler(HandlerClassT& handler)
+void EventSink<T>::removeBatchHandler(HandlerClassT& handler)
 {
-    m_Handlers.emplace_back(HandlerDelegate::template wrapMethod<HandlerMethodT>(handler));
+    m_BatchHandlers.removeDelegate(BatchHandlerDelegate::template fromMethod<HandlerMethodT>(handler));
 }
 
 template<typename T>
 template<auto HandlerFunctionT>
-void EventSink<T>::addHandler()
+void EventSink<T>::removeBatchHandler()
 {
-    m_Handlers.emplace_back(EventSink<T>::HandlerDelegate::template wrapFunction<HandlerFunctionT>());
+    m_BatchHandlers.removeDelegate(BatchHandlerDelegate::template fromFunction<HandlerFunctionT>());
 }
 
 template<typename T>
 template<auto HandlerMethodT, class HandlerClassT>
-void EventSink<T>::removeHandler(HandlerClassT& handler)
+Connection EventSink<T>::addKeyedHandler(EventKey key, HandlerClassT& handler)
 {
-    HandlerDelegate delegate{EventSink<T>::HandlerDelegate::template wrapMethod<HandlerMethodT>(handler)};
+    return connect<HandlerMethodT>(getKeyedHandlers(key),
+                                   HandlerDelegate::template fromMethod<HandlerMethodT>(handler));
+}
+
+template<typename T>
+template<auto HandlerFunctionT>
+Connection EventSink<T>::addKeyedHandler(EventKey key)
+{
+    return connect<HandlerFunctionT>(getKeyedHandlers(key), HandlerDelegate::template fromFunction<HandlerFunctionT>());
+}
 
-    for (auto it = m_Handlers.begin(); it != m_Handlers.end(); ++it)
+template<typename T>
+template<auto HandlerMethodT, class HandlerClassT>
+void EventSink<T>::removeKeyedHandler(EventKey key, HandlerClassT& handler)
+{
+    auto it = m_KeyedHandlers.find(key);
+    if (it != m_KeyedHandlers.end())
     {
-        if (delegate == *it)
-        {
-            m_Handlers.erase(it);
-            break;
-        }
+        it->second->removeDelegate(HandlerDelegate::template fromMethod<HandlerMethodT>(handler));
     }
 }
 
 template<typename T>
 template<auto HandlerFunctionT>
-void EventSink<T>::removeHandler()
+void EventSink<T>::removeKeyedHandler(EventKey key)
+{
+    auto it = m_KeyedHandlers.find(key);
+    if (it != m_KeyedHandlers.end())
+    {
+        it->second->removeDelegate(HandlerDelegate::template fromFunction<HandlerFunctionT>());
+    }
+}
+
+template<typename T>
+template<auto HandlerT, typename DelegateT>
+Connection EventSink<T>::connect(HandlerList<DelegateT>& handlers, const DelegateT& delegate)
+{
+    Connection connection = handlers.add(delegate);
+
+#ifdef GWARS_EVENT_PROFILING
+    handlers.getLastAddedProfile() = EventHandlerProfile{typeid(T).name(), getHandlerName<HandlerT>()};
+#endif
+
+    return connection;
+}
+
+/* Lists emptied by connections are only noticed on release, which is also done here once the table has doubled,
+ * so that the table stays proportional to the number of keys in use even if events are never queued */
+template<typename T>
+typename EventSink<T>::KeyedHandlerList& EventSink<T>::getKeyedHandlers(EventKey key)
 {
-    HandlerDelegate delegate{EventSink<T>::HandlerDelegate::template wrapFunction<HandlerFunctionT>()};
+    static_assert(HasRoutingKeys<T>::value, "Keyed handlers require the event to define getRoutingKeys");
 
-    for (auto it = m_Handlers.begin(); it != m_Handlers.end(); ++it)
+    if (m_KeyedHandlers.size() >= m_KeyedHandlersReleaseSize)
     {
-        if (delegate == *it)
+        releaseEmptyKeyedHandlers();
+    }
+
+    std::unique_ptr<KeyedHandlerList>& handlers = m_KeyedHandlers[key];
+    if (handlers == nullptr)
+    {
+        if (m_FreeKeyedHandlers.empty())
         {
-            m_Handlers.erase(it);
-            break;
+            handlers = std::make_unique<KeyedHandlerList>();
+        }
+        else
+        {
+            handlers = std::move(m_FreeKeyedHandlers.back());
+            m_FreeKeyedHandlers.pop_back();
         }
     }
+
+    return *handlers;
+}
+
+template<typename T>
+void EventSink<T>::releaseEmptyKeyedHandlers()
+{
+    for (auto it = m_KeyedHandlers.begin(); it != m_KeyedHandlers.end();)
+    {
+        if (it->second->empty())
+        {
+            m_FreeKeyedHandlers.push_back(std::move(it->second));
+            it = m_KeyedHandlers.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    m_KeyedHandlersReleaseSize = 2 * m_KeyedHandlers.size() + 16;
 }
 
 template<typename T>
 void EventSink<T>::fireEvent(const T& event)
 {
-    for (auto handler : m_Handlers)
+    callHandlers(event);
+
+    if (!m_BatchHandlers.empty())
+    {
+        m_BatchHandlers.call(Span<const T>(&event, 1));
+    }
+}
+
+template<typename T>
+void EventSink<T>::callHandlers(const T& event)
+{
+#ifdef GWARS_EVENT_PROFILING
+    ++m_FiredCount;
+#endif
+
+    m_Handlers.call(event);
+
+    if constexpr (HasRoutingKeys<T>::value)
+    {
+        if (!m_KeyedHandlers.empty())
+        {
+            callKeyedHandlers(event);
+        }
+    }
+}
+
+template<typename T>
+void EventSink<T>::callKeyedHandlers(const T& event)
+{
+    EventKey keys[MAX_EVENT_ROUTING_KEYS];
+    size_t   keysCount = event.getRoutingKeys(keys);
+    assert(keysCount <= MAX_EVENT_ROUTING_KEYS);
+
+    for (size_t i = 0; i < keysCount; ++i)
+    {
+        auto it = m_KeyedHandlers.find(keys[i]);
+        if (it != m_KeyedHandlers.end())
+        {
+            it->second->call(event);
+        }
+    }
+}
+
+template<typename T>
+bool EventSink<T>::enqueueEvent(const T& event)
+{
+    m_Queue.push_back(event);
+
+    if (m_Queued)
+    {
+        return false;
+    }
+
+    m_Queued = true;
+    return true;
+}
+
+template<typename T>
+void EventSink<T>::dispatchQueued()
+{
+    m_Queued = false;
+    m_Queue.swap(m_DispatchedQueue);
+
+    for (const T& event : m_DispatchedQueue)
+    {
+        callHandlers(event);
+    }
+
+    m_BatchHandlers.call(Span<const T>(m_DispatchedQueue));
+
+    m_DispatchedQueue.clear();
+
+    if constexpr (HasRoutingKeys<T>::value)
+    {
+        releaseEmptyKeyedHandlers();
+    }
+}
+
+template<typename T>
+void EventSink<T>::enablePosting(size_t capacity)
+{
+    assert(m_PostedQueue == nullptr);
+    m_PostedQueue = std::make_unique<MpscQueue<T>>(capacity);
+}
+
+template<typename T>
+bool EventSink<T>::postEvent(const T& event)
+{
+    assert(m_PostedQueue != nullptr);
+    return m_PostedQueue->tryPush(event);
+}
+
+template<typename T>
+bool EventSink<T>::drainPosted()
+{
+    assert(m_PostedQueue != nullptr);
+
+    size_t drainedCount = m_PostedQueue->consumeAll([this](T&& event) { m_Queue.push_back(std::move(event)); });
+    if (drainedCount == 0 || m_Queued)
     {
-        handler.function(event);
+        return false;
     }
+
+    m_Queued = true;
+    return true;
+}
+
+#ifdef GWARS_EVENT_PROFILING
+/* Keyed handlers are reported per handler function, summed over all the keys */
+template<typename T>
+void EventSink<T>::collectProfile(std::vector<EventHandlerProfile>& profiles) const
+{
+    size_t handlersCount = getHandlersCount();
+
+    auto appendProfile = [&](const EventHandlerProfile& profile) {
+        profiles.push_back(profile);
+        profiles.back().handlersCount = handlersCount;
+        profiles.back().firedCount    = m_FiredCount;
+    };
+
+    m_Handlers.forEachProfile(appendProfile);
+    m_BatchHandlers.forEachProfile(appendProfile);
+
+    size_t keyedBegin = profiles.size();
+    for (const auto& [key, handlers] : m_KeyedHandlers)
+    {
+        handlers->forEachProfile([&](const EventHandlerProfile& profile) {
+            for (size_t i = keyedBegin; i < profiles.size(); ++i)
+            {
+                if (strcmp(profiles[i].handlerName, profile.handlerName) == 0)
+                {
+                    profiles[i].callsCount       += profile.callsCount;
+                    profiles[i].totalNanoseconds += profile.totalNanoseconds;
+                    profiles[i].maxNanoseconds    = std::max(profiles[i].maxNanoseconds, profile.maxNanoseconds);
+                    return;
+                }
+            }
+
+            appendProfile(profile);
+        });
+    }
+}
+
+template<typename T>
+void EventSink<T>::resetProfile()
+{
+    m_Handlers.resetProfiles();
+    m_BatchHandlers.resetProfiles();
+
+    for (auto& [key, handlers] : m_KeyedHandlers)
+    {
+        handlers->resetProfiles();
+    }
+
+    m_FiredCount = 0;
+}
+#endif
+
+template<typename T>
+bool EventSink<T>::hasHandlers() const
+{
+    return !m_Handlers.empty() || !m_BatchHandlers.empty() || !m_KeyedHandlers.empty();
+}
+
+template<typename T>
+size_t EventSink<T>::getHandlersCount() const
+{
+    size_t handlersCount = m_Handlers.size() + m_BatchHandlers.size();
+    for (const auto& [key, handlers] : m_KeyedHandlers)
+    {
+        handlersCount += handlers->size();
+    }
+
+    return handlersCount;
 }
 
 } // namespace gwars
\ No newline at end of file
@@ -0,0 +1,115 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file handler_list.hpp
+ * @date 2026-10-17
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+
+#include "events/connection.hpp"
+#include "events/event_profiling.hpp"
+#include <vector>
+
+namespace gwars {
+
+/**
+ * @brief Ordered list of handler delegates, which stays valid while being called.
+ *
+ * Removed handlers are replaced with tombstones, which are compacted once no call is in progress, or
+ * during removal when they take up more than half of the list. Handlers added during a call are first
+ * called on the next one. Every handler gets an id, which maps to its position, so removal through a
+ * Connection is O(1). Id slots are reused, their generation is incremented on every removal, so removing
+ * through a stale id is detected and ignored.
+ */
+template<typename DelegateT>
+class HandlerList : public IHandlerList
+{
+public:
+    HandlerList() = default;
+
+    HandlerList(const HandlerList& other)            = delete;
+    HandlerList& operator=(const HandlerList& other) = delete;
+
+    Connection add(const DelegateT& delegate);
+    void       remove(HandlerId handlerId) override;
+
+    /**
+     * @brief Removes the first handler equal to the delegate in O(n), prefer Connection::disconnect.
+     */
+    void removeDelegate(const DelegateT& delegate);
+
+    template<typename... Args>
+    void call(const Args&... args);
+
+    size_t size() const;
+    bool   empty() const;
+
+#ifdef GWARS_EVENT_PROFILING
+    /**
+     * @brief Profile of the handler added last, lets the sink name it.
+     */
+    EventHandlerProfile& getLastAddedProfile();
+
+    template<typename FunctionT>
+    void forEachProfile(FunctionT&& function) const;
+    void resetProfiles();
+#endif
+
+private:
+    static constexpr uint32_t INVALID_POSITION = UINT32_MAX;
+
+    struct Entry
+    {
+        DelegateT delegate; ///< Unbound in tombstones
+        HandlerId handlerId{0};
+
+#ifdef GWARS_EVENT_PROFILING
+        EventHandlerProfile profile;
+#endif
+    };
+
+    struct IdSlot
+    {
+        uint32_t position{INVALID_POSITION};
+        uint32_t generation{0};
+    };
+
+    static HandlerId makeHandlerId(uint32_t slotIndex, uint32_t generation);
+
+    void compact();
+
+private:
+    std::vector<Entry>    m_Entries;
+    std::vector<IdSlot>   m_IdSlots; ///< Indexed by the lower half of handler ids
+    std::vector<uint32_t> m_FreeIdSlots;
+
+    size_t   m_AliveCount{0};
+    size_t   m_TombstonesCount{0};
+    uint32_t m_CallDepth{0};
+};
+
+} // namespace gwars
+
+#include "events/handler_list.ipp"
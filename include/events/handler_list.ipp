@@ -0,0 +1,212 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file handler_list.ipp
+ * @date 2026-10-17
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <cassert>
+
+namespace gwars {
+
+template<typename DelegateT>
+Connection HandlerList<DelegateT>::add(const DelegateT& delegate)
+{
+    uint32_t slotIndex = 0;
+    if (m_FreeIdSlots.empty())
+    {
+        slotIndex = static_cast<uint32_t>(m_IdSlots.size());
+        m_IdSlots.emplace_back();
+    }
+    else
+    {
+        slotIndex = m_FreeIdSlots.back();
+        m_FreeIdSlots.pop_back();
+    }
+
+    IdSlot& slot = m_IdSlots[slotIndex];
+
+    Entry entry;
+    entry.delegate  = delegate;
+    entry.handlerId = makeHandlerId(slotIndex, slot.generation);
+
+    slot.position = static_cast<uint32_t>(m_Entries.size());
+    m_Entries.push_back(entry);
+    ++m_AliveCount;
+
+    return Connection(this, entry.handlerId);
+}
+
+template<typename DelegateT>
+void HandlerList<DelegateT>::remove(HandlerId handlerId)
+{
+    uint64_t slotIndex = handlerId & UINT32_MAX;
+    if (slotIndex >= m_IdSlots.size())
+    {
+        return;
+    }
+
+    IdSlot& slot = m_IdSlots[slotIndex];
+    if (slot.position == INVALID_POSITION || slot.generation != static_cast<uint32_t>(handlerId >> 32))
+    {
+        return;
+    }
+
+    m_Entries[slot.position].delegate = DelegateT();
+    slot.position                     = INVALID_POSITION;
+    ++slot.generation;
+    m_FreeIdSlots.push_back(static_cast<uint32_t>(slotIndex));
+
+    --m_AliveCount;
+    ++m_TombstonesCount;
+
+    if (m_CallDepth == 0 && m_TombstonesCount * 2 > m_Entries.size())
+    {
+        compact();
+    }
+}
+
+template<typename DelegateT>
+void HandlerList<DelegateT>::removeDelegate(const DelegateT& delegate)
+{
+    for (const Entry& entry : m_Entries)
+    {
+        if (entry.delegate && entry.delegate == delegate)
+        {
+            remove(entry.handlerId);
+            return;
+        }
+    }
+}
+
+/* Entries are accessed by index, as handlers added during the call may reallocate the array */
+template<typename DelegateT>
+template<typename... Args>
+void HandlerList<DelegateT>::call(const Args&... args)
+{
+    ++m_CallDepth;
+
+    const size_t count = m_Entries.size();
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (!m_Entries[i].delegate)
+        {
+            continue;
+        }
+
+#ifdef GWARS_EVENT_PROFILING
+        EventProfilingClock::time_point start = EventProfilingClock::now();
+        m_Entries[i].delegate(args...);
+        recordHandlerCall(m_Entries[i].profile, start);
+#else
+        m_Entries[i].delegate(args...);
+#endif
+    }
+
+    --m_CallDepth;
+
+    if (m_CallDepth == 0 && m_TombstonesCount > 0)
+    {
+        compact();
+    }
+}
+
+template<typename DelegateT>
+size_t HandlerList<DelegateT>::size() const
+{
+    return m_AliveCount;
+}
+
+template<typename DelegateT>
+bool HandlerList<DelegateT>::empty() const
+{
+    return m_AliveCount == 0;
+}
+
+template<typename DelegateT>
+HandlerId HandlerList<DelegateT>::makeHandlerId(uint32_t slotIndex, uint32_t generation)
+{
+    return (static_cast<HandlerId>(generation) << 32) | slotIndex;
+}
+
+template<typename DelegateT>
+void HandlerList<DelegateT>::compact()
+{
+    size_t aliveCount = 0;
+    for (size_t i = 0; i < m_Entries.size(); ++i)
+    {
+        if (!m_Entries[i].delegate)
+        {
+            continue;
+        }
+
+        if (aliveCount != i)
+        {
+            m_Entries[aliveCount] = m_Entries[i];
+        }
+
+        m_IdSlots[m_Entries[aliveCount].handlerId & UINT32_MAX].position = static_cast<uint32_t>(aliveCount);
+        ++aliveCount;
+    }
+
+    m_Entries.resize(aliveCount);
+    m_TombstonesCount = 0;
+}
+
+#ifdef GWARS_EVENT_PROFILING
+template<typename DelegateT>
+EventHandlerProfile& HandlerList<DelegateT>::getLastAddedProfile()
+{
+    assert(!m_Entries.empty());
+    return m_Entries.back().profile;
+}
+
+template<typename DelegateT>
+template<typename FunctionT>
+void HandlerList<DelegateT>::forEachProfile(FunctionT&& function) const
+{
+    for (const Entry& entry : m_Entries)
+    {
+        if (entry.delegate)
+        {
+            function(entry.profile);
+        }
+    }
+}
+
+template<typename DelegateT>
+void HandlerList<DelegateT>::resetProfiles()
+{
+    for (Entry& entry : m_Entries)
+    {
+        entry.profile.callsCount       = 0;
+        entry.profile.totalNanoseconds = 0;
+        entry.profile.maxNanoseconds   = 0;
+    }
+}
+#endif
+
+} // namespace gwars
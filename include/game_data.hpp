@@ -55,6 +55,14 @@ struct GWarsEntityComponent
 
 constexpr size_t GWARS_ENTITY_TYPES = static_cast<size_t>(GWarsEntityComponent::EntityType::Total);
 
+/**
+ * @brief Entities' bounding spheres use their types as collision layers, see CollisionEvent.
+ */
+constexpr uint16_t getCollisionLayer(GWarsEntityComponent::EntityType entityType)
+{
+    return static_cast<uint16_t>(entityType);
+}
+
 using Score = uint64_t;
 using Level = uint64_t;
 
@@ -81,11 +89,31 @@ struct EnemyKilledEvent
     EnemyKilledEvent(Entity enemy, Score killScore) : enemy(enemy), killScore(killScore) {}
 };
 
+enum class ScriptType : uint32_t
+{
+    PlayerControl,
+    CollisionHandler,
+    EnemySpawner,
+    EnemyMovement,
+    Explosion
+};
+
+/**
+ * @brief Creates a script of the given type in its initial state, used to restore scripts from snapshots.
+ *
+ * @return nullptr if the type is unknown.
+ */
+INativeScript* createScript(ScriptType type, Scene& scene);
+
 //==================================================================================================
 // Constants
 //==================================================================================================
 extern const Polygon SPACESHIP_MODEL;
 extern const Polygon SPACESHIP_PROJECTILE_MODEL;
+extern const Polygon FIRE_PARTICLE_MODEL;
+
+extern const size_t ENTITIES_RESERVED;
+extern const float  STATS_PRINT_PERIOD;
 
 extern const Vec2f SPACESHIP_SCALE;
 extern const Vec2f SPACESHIP_FORWARD;
@@ -125,7 +153,7 @@ extern const Score UFO_SCORE;
 class PlayerControlScript : public INativeScript
 {
 public:
-    PlayerControlScript(Scene& scene) : m_Scene(scene) {}
+    PlayerControlScript(Scene& scene);
 
     virtual ~PlayerControlScript() override = default;
 
@@ -133,14 +161,17 @@ public:
     virtual void onDetach(Entity entity, EventDispatcher& eventDispatcher) override;
     virtual void onUpdate(float dt) override;
 
+    virtual uint32_t getType() const override;
+    virtual void     save(BinaryWriter& writer) const override;
+    virtual bool     load(BinaryReader& reader, Scene& scene) override;
+
 private:
     void shoot(Vec2f position, Vec2f velocity);
     void emit(Vec2f position);
 
     Vec2f calculateForward();
+    Vec2f calculateEngineForce() const;
 
-    void onKeyPressed(const KeyPressedEvent& event);
-    void onKeyReleased(const KeyReleasedEvent& event);
     void onMouseMoved(const MouseMoveEvent& event);
     void onMouseButtonPressed(const MouseButtonPressedEvent& event);
     void onMouseButtonReleased(const MouseButtonReleasedEvent& event);
@@ -150,9 +181,9 @@ private:
 private:
     Entity m_Entity;
     Scene& m_Scene;
-    Vec2f  m_EngineForce{0, 0};
     bool   m_Shooting{false};
     float  m_Recharge{0};
+    Prefab m_ProjectilePrefab;
 
     ParticleSystem::ParticleSpecs m_ParticleSpecs;
 };
@@ -170,14 +201,13 @@ public:
     virtual void onDetach(Entity entity, EventDispatcher& eventDispatcher) override;
     virtual void onUpdate(float dt) override;
 
-private:
-    void onCollisionDetected(CollisionEvent event);
-
-    void onCollisionPlayerUfo(Entity player, Entity ufo);
-    void onCollisionProjectileUfo(Entity projectile, Entity ufo);
+    virtual uint32_t getType() const override;
+    virtual void     save(BinaryWriter& writer) const override;
+    virtual bool     load(BinaryReader& reader, Scene& scene) override;
 
-    typedef void (CollisionHandlerScript::*onCollisionFunctionT)(Entity first, Entity second);
-    static const onCollisionFunctionT COLLISION_HANDLERS[GWARS_ENTITY_TYPES][GWARS_ENTITY_TYPES];
+private:
+    void onCollisionPlayerUfo(const CollisionEvent& event);
+    void onCollisionProjectileUfo(const CollisionEvent& event);
 
 private:
     Scene& m_Scene;
@@ -197,6 +227,10 @@ public:
     virtual void onDetach(Entity entity, EventDispatcher& eventDispatcher) override;
     virtual void onUpdate(float dt) override;
 
+    virtual uint32_t getType() const override;
+    virtual void     save(BinaryWriter& writer) const override;
+    virtual bool     load(BinaryReader& reader, Scene& scene) override;
+
 private:
     void onEnemyKilledEvent(const EnemyKilledEvent& event);
     void spawn();
@@ -206,6 +240,7 @@ private:
     Entity  m_Player;
     int32_t m_EnemiesLeft{0};
     Level   m_EnemyLevel{1};
+    Prefab  m_UfoPrefab;
 };
 
 //==================================================================================================
@@ -222,6 +257,10 @@ public:
     virtual void onDetach(Entity entity, EventDispatcher& eventDispatcher) override;
     virtual void onUpdate(float dt) override;
 
+    virtual uint32_t getType() const override;
+    virtual void     save(BinaryWriter& writer) const override;
+    virtual bool     load(BinaryReader& reader, Scene& scene) override;
+
 private:
     Vec2f calculateForward();
     void  emit(Vec2f position);
@@ -245,6 +284,8 @@ public:
     virtual void onDetach(Entity entity, EventDispatcher& eventDispatcher) override;
     virtual void onUpdate(float dt) override;
 
+    virtual uint32_t getType() const override;
+
 private:
     void onEnemyKilledEvent(EnemyKilledEvent event);
 
@@ -28,6 +28,7 @@
 #pragma once
 
 #include "ecs/entity.hpp"
+#include "input/keyboard.hpp"
 #include "scene/components.hpp"
 #include "scene/scene.hpp"
 
@@ -37,17 +38,44 @@ class GameLayer
 {
 public:
     GameLayer(EventDispatcher& eventDispatcher);
-
-    bool isStopped() const;
-    void setStopped(bool stopped);
+    ~GameLayer();
 
     void onInit();
     void onUpdate(float dt);
     void onRender(Renderer& renderer);
 
+    /**
+     * @brief Destroys the current round's world and creates a new one.
+     */
+    void restart();
+
+    /**
+     * @brief Writes the whole world to a binary snapshot file, done on pressing Space.
+     */
+    bool saveSnapshot(const char* filename);
+
+    /**
+     * @brief Replaces the current world with the one from a snapshot file, done on pressing Return. If
+     *        the snapshot cannot be loaded, a new round is started instead. Must not be called from onUpdate.
+     */
+    bool loadSnapshot(const char* filename);
+
+    /**
+     * @brief Prints the world's memory statistics and event handlers' profile, also done every
+     *        STATS_PRINT_PERIOD seconds.
+     */
+    void printStats();
+
+private:
+    void createWorld();
+    bool loadWorld(BinaryReader& reader);
+
+    void onKeyPressed(const KeyPressedEvent& event);
+
 private:
-    Scene m_GameScene;
-    bool  m_Stopped{false};
+    Scene            m_GameScene;
+    float            m_StatsTimer{0};
+    ScopedConnection m_KeyPressedConnection;
 };
 
 } // namespace gwars
\ No newline at end of file
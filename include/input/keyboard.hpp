@@ -60,4 +60,9 @@ struct KeyReleasedEvent
     KeyReleasedEvent(Key key) : key(key) {}
 };
 
+/**
+ * @return Whether the key is held down as of the latest KeyPressedEvent/KeyReleasedEvent fired for it.
+ */
+bool isKeyPressed(Key key);
+
 } // namespace gwars
\ No newline at end of file
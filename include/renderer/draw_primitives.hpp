@@ -29,6 +29,7 @@
 
 #include "math/mat3.hpp"
 #include "renderer/color.hpp"
+#include "utils/binary_stream.hpp"
 #include <vector>
 
 namespace gwars {
@@ -62,6 +63,11 @@ struct Polygon
                               Vec2f v3        = Vec2f(-0.5, 0.5),
                               Color color     = 0xFFFFFFFF,
                               float thickness = 1);
+
+    size_t getHeapBytes() const { return vertices.capacity() * sizeof(Vertex); }
 };
 
+void    writePolygon(BinaryWriter& writer, const Polygon& polygon);
+Polygon readPolygon(BinaryReader& reader);
+
 } // namespace gwars
\ No newline at end of file
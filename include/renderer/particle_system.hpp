@@ -57,6 +57,14 @@ public:
 
     void emit(const ParticleSpecs& particleSpecs);
 
+    void save(BinaryWriter& writer) const;
+    bool load(BinaryReader& reader);
+
+    /**
+     * @return Size of the particle pool and the particle polygon, which are allocated on the heap.
+     */
+    size_t getHeapBytes() const;
+
 private:
     struct Particle
     {
@@ -27,6 +27,7 @@
 
 #pragma once
 
+#include "ecs/entity_manager.hpp"
 #include "math/mat3.hpp"
 #include "renderer/camera.hpp"
 #include "renderer/draw_primitives.hpp"
@@ -65,6 +66,51 @@ struct TransformComponent
     Mat3f calculateScaleMatrix() const { return gwars::scaleMatrix(scale); }
 };
 
+/**
+ * @brief Links the entity into a transform hierarchy, in which TransformComponent is relative to the
+ *        parent. Children form a singly linked list, see setParent.
+ */
+struct HierarchyComponent
+{
+    EntityId parent{INVALID_ENTITY_ID};
+    EntityId firstChild{INVALID_ENTITY_ID};
+    EntityId nextSibling{INVALID_ENTITY_ID};
+};
+
+/**
+ * @brief Cached local-to-world matrix, which TransformSystem computes from the entity's and its
+ *        ancestors' TransformComponent once per frame.
+ */
+struct WorldTransformComponent
+{
+    Mat3f matrix{{1, 0, 0, 0, 1, 0, 0, 0, 1}};
+
+    Vec2f getTranslation() const { return Vec2f(matrix[0][2], matrix[1][2]); }
+    Vec2f getScale() const
+    {
+        return Vec2f(sqrtf(matrix[0][0] * matrix[0][0] + matrix[1][0] * matrix[1][0]),
+                     sqrtf(matrix[0][1] * matrix[0][1] + matrix[1][1] * matrix[1][1]));
+    }
+};
+
+/**
+ * @brief Makes the child a child of the parent, or a root if the parent is INVALID_ENTITY_ID. Adds
+ *        HierarchyComponent to both entities if needed.
+ */
+void setParent(EntityManager& manager, EntityId child, EntityId parent);
+
+/**
+ * @brief Unlinks the entity from its parent and makes its children roots, must be called before the
+ *        entity's HierarchyComponent is removed.
+ */
+void unlinkFromHierarchy(EntityManager& manager, EntityId id);
+
+/**
+ * @brief Checks that hierarchy links only refer to entities with HierarchyComponent, that parents and
+ *        children agree and that there are no cycles, e.g. after loading a snapshot.
+ */
+bool isValidHierarchy(EntityManager& manager);
+
 struct CameraComponent
 {
     OrthographicCameraSpecs cameraSpecs;
@@ -83,6 +129,8 @@ struct PolygonComponent
 
     PolygonComponent() = default;
     PolygonComponent(const Polygon& polygon) : polygon(polygon) {}
+
+    size_t getHeapBytes() const { return polygon.getHeapBytes(); }
 };
 
 struct ScriptComponent
@@ -91,6 +139,23 @@ struct ScriptComponent
 
     ScriptComponent(INativeScript* nativeScript = nullptr) : nativeScript(nativeScript) {}
 
+    ScriptComponent(const ScriptComponent& other) = delete;
+    ScriptComponent& operator=(const ScriptComponent& other) = delete;
+
+    ScriptComponent(ScriptComponent&& other) : nativeScript(other.nativeScript) { other.nativeScript = nullptr; }
+
+    ScriptComponent& operator=(ScriptComponent&& other)
+    {
+        if (this != &other)
+        {
+            delete nativeScript;
+            nativeScript       = other.nativeScript;
+            other.nativeScript = nullptr;
+        }
+
+        return *this;
+    }
+
     ~ScriptComponent() { delete nativeScript; }
 };
 
@@ -111,8 +176,11 @@ struct BoundingSphereComponent
     Vec2f wsTranslation{0, 0};
     float wsRadius{0};
 
-    BoundingSphereComponent(float msRadius = 1, Vec2f msTranslation = Vec2f(0, 0))
-        : msTranslation(msTranslation), msRadius(msRadius)
+    /* Lets collision handlers subscribe to pairs of layers, see CollisionEvent */
+    uint16_t collisionLayer{0};
+
+    BoundingSphereComponent(float msRadius = 1, Vec2f msTranslation = Vec2f(0, 0), uint16_t collisionLayer = 0)
+        : msTranslation(msTranslation), msRadius(msRadius), collisionLayer(collisionLayer)
     {
     }
 };
@@ -127,6 +195,8 @@ struct ParticleSystemComponent
         : particleSystem(poolSize, particlePolygon)
     {
     }
+
+    size_t getHeapBytes() const { return particleSystem.getHeapBytes(); }
 };
 
 } // namespace gwars
\ No newline at end of file
@@ -0,0 +1,127 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file rigid_body_storage.hpp
+ * @date 2026-10-17
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include "ecs/entity_id.hpp"
+#include "math/vec2.hpp"
+#include <stddef.h>
+#include <vector>
+
+namespace gwars {
+
+/**
+ * @brief Alternative to PhysicsComponent and TransformComponent pools for large amounts of bodies, which
+ *        are moved by physics only (debris, bullets).
+ *
+ * Every property of the bodies is stored in its own column, a persistent array of floats aligned for SIMD
+ * loads, so integration streams through contiguous memory BLOCK_SIZE bodies at a time with no per-body
+ * lookups. Columns are padded to whole blocks with bodies at rest, so the kernel needs no scalar tail.
+ * Removal moves the last body into the freed slot, same as in SparseSet.
+ */
+class RigidBodyStorage
+{
+public:
+    enum Column : size_t
+    {
+        COLUMN_TRANSLATION_X,
+        COLUMN_TRANSLATION_Y,
+        COLUMN_VELOCITY_X,
+        COLUMN_VELOCITY_Y,
+        COLUMN_FORCE_X,
+        COLUMN_FORCE_Y,
+        COLUMN_MASS,
+
+        COLUMNS_COUNT
+    };
+
+    static constexpr size_t BLOCK_SIZE       = 8;
+    static constexpr size_t COLUMN_ALIGNMENT = 32;
+
+    RigidBodyStorage() = default;
+    ~RigidBodyStorage();
+
+    RigidBodyStorage(const RigidBodyStorage& other)            = delete;
+    RigidBodyStorage& operator=(const RigidBodyStorage& other) = delete;
+
+    void addBody(EntityId id, const Vec2f& translation, const Vec2f& velocity = Vec2f(0, 0), float mass = 1);
+    void removeBody(EntityId id);
+    bool contains(EntityId id) const;
+    void clear();
+    void reserve(size_t capacity);
+
+    Vec2f getTranslation(EntityId id) const;
+    Vec2f getVelocity(EntityId id) const;
+    Vec2f getForce(EntityId id) const;
+    float getMass(EntityId id) const;
+
+    void setTranslation(EntityId id, const Vec2f& translation);
+    void setVelocity(EntityId id, const Vec2f& velocity);
+    void setForce(EntityId id, const Vec2f& force);
+    void setMass(EntityId id, float mass);
+
+    /**
+     * @brief Semi-implicit Euler step of all bodies, same as PhysicsSystem's: velocity += force / mass * dt,
+     *        then translation += velocity * dt.
+     *
+     * Processes 8 bodies per instruction if the engine is built with AVX (see GWARS_ENABLE_AVX), 4 with
+     * SSE2, and one at a time elsewhere.
+     */
+    void integrate(float dt);
+
+    /**
+     * @brief Same step as integrate, but without SIMD intrinsics. Reference for tests and benchmarks.
+     */
+    void integrateScalar(float dt);
+
+    /**
+     * @return Column of capacity() floats, the first size() of which belong to the bodies in the order
+     *         of getEntities().
+     */
+    float*       getColumn(Column column);
+    const float* getColumn(Column column) const;
+
+    const EntityId* getEntities() const;
+
+    size_t size() const;
+    size_t capacity() const;
+
+private:
+    static constexpr uint32_t INVALID_POSITION = UINT32_MAX;
+
+    size_t getPosition(EntityId id) const;
+    void   resetBodies(size_t begin, size_t end);
+
+private:
+    /* All columns share a single allocation, each of them is m_Capacity floats long */
+    float*                m_Columns{nullptr};
+    size_t                m_Capacity{0};
+    std::vector<EntityId> m_Entities;
+    std::vector<uint32_t> m_Positions;
+};
+
+} // namespace gwars
@@ -27,21 +27,36 @@
 
 #pragma once
 
+#include "ecs/command_buffer.hpp"
 #include "ecs/entity.hpp"
+#include "ecs/query.hpp"
+#include "ecs/system_scheduler.hpp"
 #include "events/event_dispatcher.hpp"
 #include "renderer/renderer.hpp"
 #include "scene/components.hpp"
-#include <set>
+#include "utils/thread_index.hpp"
 
 namespace gwars {
 
+/**
+ * @brief Entities are ordered so that the first one's collision layer isn't greater than the second's.
+ *        Keyed handlers can subscribe either to collisions of a specific entity, see makeEntityKey, or
+ *        to collisions between two layers, see makeLayersKey.
+ */
 struct CollisionEvent
 {
-    Entity firstEntity;
-    Entity secondEntity;
+    EntityId firstEntity{INVALID_ENTITY_ID};
+    EntityId secondEntity{INVALID_ENTITY_ID};
+    uint16_t firstLayer{0};
+    uint16_t secondLayer{0};
 
     CollisionEvent() = default;
-    CollisionEvent(Entity firstEntity, Entity secondEntity);
+    CollisionEvent(EntityId firstEntity, EntityId secondEntity, uint16_t firstLayer = 0, uint16_t secondLayer = 0);
+
+    size_t getRoutingKeys(EventKey* keys) const;
+
+    static EventKey makeEntityKey(EntityId id);
+    static EventKey makeLayersKey(uint16_t firstLayer, uint16_t secondLayer);
 };
 
 class Scene
@@ -50,9 +65,24 @@ public:
     Scene(EventDispatcher& eventDispatcher);
 
     Entity createEntity();
-    void   submitToRemoveEntity(Entity entity);
+    Entity getEntity(EntityId id);
 
-    bool isSubmittedToRemove(Entity entity);
+    /**
+     * @brief Records entity's destruction into the calling thread's command buffer and marks the
+     *        entity as pending destruction. Must be called from the main thread.
+     */
+    void submitToRemoveEntity(Entity entity);
+    bool isSubmittedToRemove(Entity entity) const;
+
+    /**
+     * @return Command buffer of the calling thread, which is flushed at the end of onUpdate.
+     */
+    CommandBuffer& getCommandBuffer();
+
+    /**
+     * @brief Sync point, which applies every thread's recorded commands in thread index order.
+     */
+    void flushCommandBuffers();
 
     EntityManager&   getEntityManager();
     EventDispatcher& getEventDispatcher();
@@ -61,6 +91,11 @@ public:
     bool isStopped() const;
     void setStropped(bool stopped);
 
+    /**
+     * @brief Destroys all entities at once, detaching their scripts. Must not be called from onUpdate.
+     */
+    void clear();
+
     void onInit();
     void onUpdate(float dt);
     void render(Renderer& renderer);
@@ -68,14 +103,22 @@ public:
 private:
     void onScriptAdded(const EventComponentConstruct<ScriptComponent>& event);
     void onScriptRemoved(const EventComponentRemove<ScriptComponent>& event);
+    void onScriptsRemoved(const EventComponentRemoveBatch<ScriptComponent>& event);
     void onCameraAdded(const EventComponentConstruct<CameraComponent>& event);
+    void onHierarchyRemoved(const EventComponentRemove<HierarchyComponent>& event);
+    void onHierarchiesRemoved(const EventComponentRemoveBatch<HierarchyComponent>& event);
 
 private:
-    EntityManager    m_Entities;
-    EventDispatcher& m_EventDispatcher;
-    Entity           m_MainCamera;
-    std::set<Entity> m_EntitiesToRemove;
-    bool             m_Stopped{true};
+    EntityManager              m_Entities;
+    EventDispatcher&           m_EventDispatcher;
+    Entity                     m_MainCamera;
+    std::vector<CommandBuffer> m_CommandBuffers;
+    std::vector<bool>          m_PendingDestroy;
+    SystemScheduler            m_Scheduler;
+    ISystem*                   m_TransformSystem{nullptr};
+    bool                       m_Stopped{true};
+
+    Query<Exclude<>, const PolygonComponent, const WorldTransformComponent> m_Renderables;
 };
 
 } // namespace gwars
\ No newline at end of file
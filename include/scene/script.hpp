@@ -27,10 +27,17 @@
 
 #pragma once
 
+#include "events/connection.hpp"
+#include <stdint.h>
+#include <vector>
+
 namespace gwars {
 
 class Entity;
 class EventDispatcher;
+class BinaryWriter;
+class BinaryReader;
+class Scene;
 
 class INativeScript
 {
@@ -40,6 +47,24 @@ public:
     virtual void onAttach(Entity entity, EventDispatcher& eventDispatcher) = 0;
     virtual void onDetach(Entity entity, EventDispatcher& eventDispatcher) = 0;
     virtual void onUpdate(float dt) = 0;
+
+    /**
+     * @return Id of the script's class, which is used to recreate the script when loading a snapshot.
+     */
+    virtual uint32_t getType() const = 0;
+
+    /**
+     * @brief Snapshot hooks for the script's state. Loading happens before the script is attached, after
+     *        all other components have been loaded.
+     *
+     * @return False if the loaded state is invalid, e.g. refers to an entity, which doesn't exist.
+     */
+    virtual void save(BinaryWriter& /*writer*/) const {}
+    virtual bool load(BinaryReader& /*reader*/, Scene& /*scene*/) { return true; }
+
+protected:
+    /* Handlers subscribed in onAttach, which scripts clear in onDetach */
+    std::vector<ScopedConnection> m_Connections;
 };
 
 } // namespace gwars
\ No newline at end of file
@@ -0,0 +1,144 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file systems.hpp
+ * @date 2026-10-16
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+
+#include "ecs/query.hpp"
+#include "ecs/system.hpp"
+#include "scene/scene.hpp"
+
+namespace gwars {
+
+class ScriptSystem : public ISystem
+{
+public:
+    ScriptSystem(Scene& scene);
+
+    void declareAccess(SystemAccess& access) const override;
+    void onUpdate(float dt) override;
+
+private:
+    Scene& m_Scene;
+};
+
+class ParticleSystemUpdateSystem : public ISystem
+{
+public:
+    ParticleSystemUpdateSystem(Scene& scene);
+
+    void declareAccess(SystemAccess& access) const override;
+    void onUpdate(float dt) override;
+
+private:
+    Scene& m_Scene;
+};
+
+class PhysicsSystem : public ISystem
+{
+public:
+    PhysicsSystem(Scene& scene);
+
+    void declareAccess(SystemAccess& access) const override;
+    void onUpdate(float dt) override;
+
+private:
+    Scene&                                                              m_Scene;
+    Query<Exclude<>, const PhysicsComponent, const TransformComponent> m_Bodies;
+};
+
+/**
+ * @brief Propagates transforms down the hierarchy into WorldTransformComponent.
+ *
+ * Only the subtrees under entities whose transform or hierarchy links have changed (or whose world
+ * transform has just been created) since the previous run are recomputed, each of them once, parents
+ * before children. Clean subtrees are not visited.
+ */
+class TransformSystem : public ISystem
+{
+public:
+    TransformSystem(Scene& scene);
+
+    void declareAccess(SystemAccess& access) const override;
+    void onUpdate(float dt) override;
+
+private:
+    bool isDirty(EntityId id) const;
+    bool hasDirtyAncestor(EntityId id) const;
+    void updateRoot(EntityId id);
+    void updateSubtree(EntityId id, const Mat3f& parentMatrix);
+
+private:
+    Scene&         m_Scene;
+    EntityManager& m_Entities;
+    uint64_t       m_TransformVersion{0};
+    uint64_t       m_HierarchyVersion{0};
+    uint64_t       m_WorldTransformVersion{0};
+
+    /* Version of world transforms at the beginning of the current run, later ones are already updated */
+    uint64_t m_RunVersion{0};
+};
+
+/**
+ * @brief Updates world-space bounding spheres, only of the entities, which have moved or whose bounding
+ *        sphere has been changed since the previous run.
+ */
+class BoundingSphereSystem : public ISystem
+{
+public:
+    BoundingSphereSystem(Scene& scene);
+
+    void declareAccess(SystemAccess& access) const override;
+    void onUpdate(float dt) override;
+
+private:
+    static void update(BoundingSphereComponent& boundingSphereComponent, const WorldTransformComponent& worldTransform);
+
+private:
+    Scene&   m_Scene;
+    uint64_t m_WorldTransformVersion{0};
+    uint64_t m_BoundingSphereVersion{0};
+};
+
+/**
+ * @brief Enqueues CollisionEvent for every unordered pair of colliding bounding spheres, so handlers
+ *        don't modify the scene during the detection. Exclusive, because enqueueing events isn't
+ *        thread-safe.
+ */
+class CollisionSystem : public ISystem
+{
+public:
+    CollisionSystem(Scene& scene);
+
+    void declareAccess(SystemAccess& access) const override;
+    void onUpdate(float dt) override;
+
+private:
+    Scene& m_Scene;
+};
+
+} // namespace gwars
@@ -0,0 +1,101 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file binary_stream.hpp
+ * @date 2026-10-16
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace gwars {
+
+/**
+ * @brief Accumulates binary data in memory, which can then be written to a file at once.
+ *
+ * Blocks can be aligned (relative to the start of the data), so that a reader over a memory mapped
+ * copy of the data can access them in place.
+ */
+class BinaryWriter
+{
+public:
+    void write(const void* data, size_t size);
+    void writeBlock(const void* data, size_t size, size_t alignment);
+
+    template<typename T>
+    void writeValue(const T& value);
+
+    const std::vector<uint8_t>& getData() const;
+
+    bool saveToFile(const char* filename) const;
+
+private:
+    std::vector<uint8_t> m_Data;
+};
+
+/**
+ * @brief Reads binary data written by BinaryWriter from memory without copying it.
+ *
+ * Reading past the end of the data fails the reader, after which every read fails, so a sequence of
+ * reads can be checked once with isFailed().
+ */
+class BinaryReader
+{
+public:
+    BinaryReader(const void* data, size_t size);
+
+    bool read(void* data, size_t size);
+
+    /**
+     * @return Pointer to the block inside of the reader's data, nullptr if the data is too short.
+     */
+    const void* readBlock(size_t size, size_t alignment);
+
+    /**
+     * @brief Same as readBlock for count elements, but the count is checked against the remaining data
+     *        first, so that a corrupt count can't overflow the block's size.
+     */
+    const void* readArray(uint64_t count, size_t elementSize, size_t alignment);
+
+    /**
+     * @return Read value or a value-initialized T if the data is too short.
+     */
+    template<typename T>
+    T readValue();
+
+    bool isFailed() const;
+
+private:
+    const uint8_t* m_Data;
+    size_t         m_Size;
+    size_t         m_Offset{0};
+    bool           m_Failed{false};
+};
+
+} // namespace gwars
+
+#include "utils/binary_stream.ipp"
@@ -1,7 +1,7 @@
 /**
  * @author Nikita Mochalov (github.com/tralf-strues)
- * @file component_holder.ipp
- * @date 2022-05-22
+ * @file binary_stream.ipp
+ * @date 2026-10-16
  *
  * The MIT License (MIT)
  * Copyright (c) 2022 Nikita Mochalov
@@ -25,33 +25,29 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+
 #pragma once
 
-#include <utility>
+#include <type_traits>
 
 namespace gwars {
 
-extern uint32_t s_NextComponentTypeId;
-
-template<typename T>
-ComponentTypeId ComponentHolder<T>::s_TypeId{s_NextComponentTypeId++};
-
 template<typename T>
-template<typename... Args>
-ComponentHolder<T>::ComponentHolder(Args&&... args) : m_Component(std::forward<Args>(args)...)
+void BinaryWriter::writeValue(const T& value)
 {
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be written as raw bytes");
+    write(&value, sizeof(T));
 }
 
 template<typename T>
-T& ComponentHolder<T>::get()
+T BinaryReader::readValue()
 {
-    return m_Component;
-}
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be read as raw bytes");
 
-template<typename T>
-ComponentTypeId ComponentHolder<T>::getTypeId()
-{
-    return s_TypeId;
+    T value{};
+    read(&value, sizeof(T));
+
+    return value;
 }
 
-} // namespace gwars
\ No newline at end of file
+} // namespace gwars
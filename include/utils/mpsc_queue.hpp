@@ -0,0 +1,102 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file mpsc_queue.hpp
+ * @date 2026-10-17
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <stddef.h>
+#include <type_traits>
+
+namespace gwars {
+
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+/**
+ * @brief Bounded lock-free multi-producer single-consumer ring buffer.
+ *
+ * Every cell has a sequence number telling whether it is free for the producer of the given position
+ * or holds a value for the consumer, so producers only contend on a single CAS of the enqueue position
+ * and never block. Pushing to a full queue fails instead of waiting.
+ */
+template<typename T>
+class MpscQueue
+{
+public:
+    /**
+     * @param capacity Rounded up to a power of two, at least 2.
+     */
+    explicit MpscQueue(size_t capacity);
+    ~MpscQueue();
+
+    MpscQueue(const MpscQueue& other)            = delete;
+    MpscQueue& operator=(const MpscQueue& other) = delete;
+
+    /**
+     * @brief Can be called from any thread.
+     *
+     * @return False if the queue is full.
+     */
+    bool tryPush(const T& value);
+
+    /**
+     * @brief Must be called from the consumer thread only.
+     *
+     * @return False if the queue is empty.
+     */
+    bool tryPop(T& value);
+
+    /**
+     * @brief Pops all values pushed before the call and passes each one to the consumer as T&&, must be
+     *        called from the consumer thread only. Values pushed by the consumer itself are left in the queue.
+     *
+     * @return Number of consumed values.
+     */
+    template<typename ConsumerT>
+    size_t consumeAll(ConsumerT&& consumer);
+
+    size_t getCapacity() const;
+
+private:
+    struct Cell
+    {
+        std::atomic<size_t>                           sequence;
+        std::aligned_storage_t<sizeof(T), alignof(T)> storage;
+    };
+
+private:
+    std::unique_ptr<Cell[]> m_Cells;
+    size_t                  m_Mask{0};
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_EnqueuePosition{0};
+    alignas(CACHE_LINE_SIZE) size_t m_DequeuePosition{0};
+};
+
+} // namespace gwars
+
+#include "utils/mpsc_queue.ipp"
@@ -0,0 +1,160 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file mpsc_queue.ipp
+ * @date 2026-10-17
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <cassert>
+#include <new>
+
+namespace gwars {
+
+template<typename T>
+MpscQueue<T>::MpscQueue(size_t capacity)
+{
+    assert(capacity > 0);
+
+    /* With a single cell a filled cell's sequence would equal the next enqueue position and look free */
+    size_t roundedCapacity = 2;
+    while (roundedCapacity < capacity)
+    {
+        roundedCapacity *= 2;
+    }
+
+    m_Cells.reset(new Cell[roundedCapacity]);
+    m_Mask = roundedCapacity - 1;
+
+    for (size_t i = 0; i < roundedCapacity; ++i)
+    {
+        m_Cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+template<typename T>
+MpscQueue<T>::~MpscQueue()
+{
+    /* Destroys the values, which haven't been popped */
+    while (m_Cells[m_DequeuePosition & m_Mask].sequence.load(std::memory_order_acquire) == m_DequeuePosition + 1)
+    {
+        std::launder(reinterpret_cast<T*>(&m_Cells[m_DequeuePosition & m_Mask].storage))->~T();
+        ++m_DequeuePosition;
+    }
+}
+
+template<typename T>
+bool MpscQueue<T>::tryPush(const T& value)
+{
+    size_t position = m_EnqueuePosition.load(std::memory_order_relaxed);
+    Cell*  cell     = nullptr;
+
+    while (true)
+    {
+        cell = &m_Cells[position & m_Mask];
+
+        size_t    sequence   = cell->sequence.load(std::memory_order_acquire);
+        ptrdiff_t difference = static_cast<ptrdiff_t>(sequence) - static_cast<ptrdiff_t>(position);
+
+        if (difference == 0)
+        {
+            /* The cell is free for this position, claim it */
+            if (m_EnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (difference < 0)
+        {
+            /* The consumer hasn't freed the cell a whole lap ago */
+            return false;
+        }
+        else
+        {
+            position = m_EnqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    new (&cell->storage) T(value);
+    cell->sequence.store(position + 1, std::memory_order_release);
+
+    return true;
+}
+
+template<typename T>
+bool MpscQueue<T>::tryPop(T& value)
+{
+    Cell& cell = m_Cells[m_DequeuePosition & m_Mask];
+
+    if (cell.sequence.load(std::memory_order_acquire) != m_DequeuePosition + 1)
+    {
+        return false;
+    }
+
+    T* stored = std::launder(reinterpret_cast<T*>(&cell.storage));
+    value     = std::move(*stored);
+    stored->~T();
+
+    cell.sequence.store(m_DequeuePosition + m_Mask + 1, std::memory_order_release);
+    ++m_DequeuePosition;
+
+    return true;
+}
+
+template<typename T>
+template<typename ConsumerT>
+size_t MpscQueue<T>::consumeAll(ConsumerT&& consumer)
+{
+    /* Values pushed during the call, possibly by the consumer itself, are left for the next call */
+    const size_t endPosition   = m_EnqueuePosition.load(std::memory_order_relaxed);
+    size_t       consumedCount = 0;
+
+    while (m_DequeuePosition != endPosition)
+    {
+        Cell& cell = m_Cells[m_DequeuePosition & m_Mask];
+        if (cell.sequence.load(std::memory_order_acquire) != m_DequeuePosition + 1)
+        {
+            break;
+        }
+
+        T* stored = std::launder(reinterpret_cast<T*>(&cell.storage));
+        consumer(std::move(*stored));
+        stored->~T();
+
+        cell.sequence.store(m_DequeuePosition + m_Mask + 1, std::memory_order_release);
+        ++m_DequeuePosition;
+        ++consumedCount;
+    }
+
+    return consumedCount;
+}
+
+template<typename T>
+size_t MpscQueue<T>::getCapacity() const
+{
+    return m_Mask + 1;
+}
+
+} // namespace gwars
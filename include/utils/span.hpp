@@ -0,0 +1,75 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file span.hpp
+ * @date 2026-10-17
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace gwars {
+
+/**
+ * @brief Non-owning view of a contiguous array, a minimal substitute for C++20 std::span.
+ */
+template<typename T>
+class Span
+{
+public:
+    Span() = default;
+    Span(T* data, size_t size) : m_Data(data), m_Size(size) {}
+
+    template<typename U, typename Allocator>
+    Span(const std::vector<U, Allocator>& vector) : m_Data(vector.data()), m_Size(vector.size())
+    {
+    }
+
+    template<typename U, typename Allocator>
+    Span(std::vector<U, Allocator>& vector) : m_Data(vector.data()), m_Size(vector.size())
+    {
+    }
+
+    T*     data() const { return m_Data; }
+    size_t size() const { return m_Size; }
+    bool   empty() const { return m_Size == 0; }
+
+    T* begin() const { return m_Data; }
+    T* end() const { return m_Data + m_Size; }
+
+    T& operator[](size_t index) const
+    {
+        assert(index < m_Size);
+        return m_Data[index];
+    }
+
+private:
+    T*     m_Data{nullptr};
+    size_t m_Size{0};
+};
+
+} // namespace gwars
@@ -0,0 +1,57 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file thread_index.hpp
+ * @date 2026-10-16
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <inttypes.h>
+
+namespace gwars {
+
+constexpr uint32_t MAX_THREADS = 64;
+
+/**
+ * @brief Returns a small index unique to the calling thread, which can be used to access per-thread
+ *        data without locking. A thread gets the lowest free index on its first call (so normally the
+ *        main thread gets index 0), and the index is freed when the thread exits.
+ *
+ * Aborts if more than MAX_THREADS threads hold an index at the same time.
+ */
+uint32_t getThreadIndex();
+
+/**
+ * @brief Reserves an index for a thread about to be started, which must pass it to bindThreadIndex
+ *        before calling getThreadIndex. Lets thread pools check the limit when they are created.
+ * @return Reserved index or MAX_THREADS if all indices are in use.
+ */
+uint32_t reserveThreadIndex();
+
+/**
+ * @brief Makes the reserved index the calling thread's one.
+ */
+void bindThreadIndex(uint32_t index);
+
+} // namespace gwars
@@ -0,0 +1,86 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file thread_pool.hpp
+ * @date 2026-10-16
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <stdint.h>
+#include <thread>
+#include <vector>
+
+namespace gwars {
+
+/**
+ * @brief Fixed set of worker threads executing submitted jobs.
+ *
+ * Jobs are plain function pointers with user data, so submitting doesn't allocate once the job queue
+ * has grown to its peak size. The order in which queued jobs are started is unspecified.
+ */
+class ThreadPool
+{
+public:
+    using JobFunction = void (*)(void* data);
+
+    /**
+     * @brief Starts the workers, each of which takes a thread index (see getThreadIndex). If there are
+     *        fewer free indices than requested workers, only that many are started.
+     */
+    explicit ThreadPool(size_t threadsCount);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool& other)            = delete;
+    ThreadPool& operator=(const ThreadPool& other) = delete;
+
+    void submit(JobFunction function, void* data);
+
+    size_t getThreadsCount() const;
+
+    /**
+     * @return Number of worker threads worth starting on this machine, leaving one core to the main thread.
+     */
+    static size_t getDefaultThreadsCount();
+
+private:
+    struct Job
+    {
+        JobFunction function{nullptr};
+        void*       data{nullptr};
+    };
+
+    void workerLoop(uint32_t threadIndex);
+
+private:
+    std::vector<std::thread> m_Threads;
+    std::vector<Job>         m_Jobs;
+    std::mutex               m_Mutex;
+    std::condition_variable  m_JobSubmitted;
+    bool                     m_Stopping{false};
+};
+
+} // namespace gwars
@@ -36,6 +36,8 @@ void processKeyEvent(uint32_t platformKey, Key key)
     }
 }
 
+bool gwars::isKeyPressed(Key key) { return g_KeyPressed[static_cast<uint32_t>(key)]; }
+
 void processMouseMoveEvent()
 {
     g_MousePos = g_Renderer.frameBufferToNdc(Vec2f(get_cursor_x(), get_cursor_y()));
@@ -94,7 +96,7 @@ void initialize()
 
 void act(float dt)
 {
-    if (is_key_pressed(VK_ESCAPE) || g_GameLayer->isStopped())
+    if (is_key_pressed(VK_ESCAPE))
     {
         schedule_quit_game();
     }
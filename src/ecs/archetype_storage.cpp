@@ -0,0 +1,418 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file archetype_storage.cpp
+ * @date 2026-10-16
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ecs/archetype_storage.hpp"
+#include <algorithm>
+#include <new>
+
+using namespace gwars;
+
+//==================================================================================================
+// Archetype
+//==================================================================================================
+static size_t alignOffset(size_t offset, size_t alignment) { return (offset + alignment - 1) / alignment * alignment; }
+
+Archetype::Archetype(std::vector<ComponentColumnInfo> columns) : m_Columns(std::move(columns))
+{
+    m_ColumnOffsets.resize(m_Columns.size());
+
+    size_t rowSize = sizeof(EntityId);
+    for (const auto& column : m_Columns)
+    {
+        m_Signature.set(column.typeId);
+        rowSize += column.size;
+    }
+
+    /* Find the largest capacity for which the column layout (including alignment padding) fits into a chunk */
+    uint32_t capacity = static_cast<uint32_t>(std::max<size_t>(CHUNK_SIZE / rowSize, 1));
+    for (;; --capacity)
+    {
+        size_t offset = capacity * sizeof(EntityId);
+        for (size_t i = 0; i < m_Columns.size(); ++i)
+        {
+            offset             = alignOffset(offset, m_Columns[i].alignment);
+            m_ColumnOffsets[i] = offset;
+            offset += capacity * m_Columns[i].size;
+        }
+
+        if (offset <= CHUNK_SIZE || capacity == 1)
+        {
+            m_ChunkBytes = std::max(offset, CHUNK_SIZE);
+            break;
+        }
+    }
+
+    m_ChunkCapacity = capacity;
+}
+
+Archetype::~Archetype() { clear(); }
+
+const std::vector<ComponentColumnInfo>& Archetype::getColumns() const { return m_Columns; }
+const ComponentSignature&               Archetype::getSignature() const { return m_Signature; }
+
+int32_t Archetype::findColumn(ComponentTypeId typeId) const
+{
+    for (size_t i = 0; i < m_Columns.size(); ++i)
+    {
+        if (m_Columns[i].typeId == typeId)
+        {
+            return static_cast<int32_t>(i);
+        }
+    }
+
+    return -1;
+}
+
+Archetype* Archetype::getAddEdge(ComponentTypeId typeId) const
+{
+    assert(typeId < MAX_COMPONENT_TYPES);
+    return m_AddEdges[typeId];
+}
+
+Archetype* Archetype::getRemoveEdge(ComponentTypeId typeId) const
+{
+    assert(typeId < MAX_COMPONENT_TYPES);
+    return m_RemoveEdges[typeId];
+}
+
+void Archetype::setAddEdge(ComponentTypeId typeId, Archetype* archetype)
+{
+    assert(typeId < MAX_COMPONENT_TYPES);
+    m_AddEdges[typeId] = archetype;
+}
+
+void Archetype::setRemoveEdge(ComponentTypeId typeId, Archetype* archetype)
+{
+    assert(typeId < MAX_COMPONENT_TYPES);
+    m_RemoveEdges[typeId] = archetype;
+}
+
+uint32_t Archetype::allocateRow(EntityId id)
+{
+    uint32_t row = m_Size;
+    if (row / m_ChunkCapacity == m_Chunks.size())
+    {
+        m_Chunks.push_back(static_cast<uint8_t*>(::operator new(m_ChunkBytes, std::align_val_t(CHUNK_ALIGNMENT))));
+    }
+
+    uint8_t* chunk = m_Chunks[row / m_ChunkCapacity];
+    reinterpret_cast<EntityId*>(chunk)[row % m_ChunkCapacity] = id;
+
+    ++m_Size;
+    return row;
+}
+
+EntityId Archetype::removeRow(uint32_t row)
+{
+    assert(row < m_Size);
+
+    for (size_t column = 0; column < m_Columns.size(); ++column)
+    {
+        m_Columns[column].destroy(getComponent(row, column));
+    }
+
+    return fillHole(row);
+}
+
+EntityId Archetype::releaseRow(uint32_t row)
+{
+    assert(row < m_Size);
+    return fillHole(row);
+}
+
+void Archetype::clear()
+{
+    while (m_Size > 0)
+    {
+        removeRow(m_Size - 1);
+    }
+
+    freeChunks(0);
+}
+
+EntityId Archetype::fillHole(uint32_t row)
+{
+    uint32_t last = m_Size - 1;
+
+    if (row == last)
+    {
+        --m_Size;
+        freeChunks(getChunksCount() + 1);
+
+        return INVALID_ENTITY_ID;
+    }
+
+    for (size_t column = 0; column < m_Columns.size(); ++column)
+    {
+        void* lastComponent = getComponent(last, column);
+
+        m_Columns[column].moveConstruct(getComponent(row, column), lastComponent);
+        m_Columns[column].destroy(lastComponent);
+    }
+
+    EntityId moved = getEntity(last);
+    reinterpret_cast<EntityId*>(m_Chunks[row / m_ChunkCapacity])[row % m_ChunkCapacity] = moved;
+
+    --m_Size;
+    freeChunks(getChunksCount() + 1);
+
+    return moved;
+}
+
+void Archetype::freeChunks(size_t keptCount)
+{
+    while (m_Chunks.size() > keptCount)
+    {
+        ::operator delete(m_Chunks.back(), std::align_val_t(CHUNK_ALIGNMENT));
+        m_Chunks.pop_back();
+    }
+}
+
+void* Archetype::getComponent(uint32_t row, size_t column)
+{
+    assert(row < m_Size);
+    return m_Chunks[row / m_ChunkCapacity] + m_ColumnOffsets[column] + (row % m_ChunkCapacity) * m_Columns[column].size;
+}
+
+void* Archetype::getColumn(size_t chunk, size_t column)
+{
+    assert(chunk < m_Chunks.size());
+    return m_Chunks[chunk] + m_ColumnOffsets[column];
+}
+
+EntityId Archetype::getEntity(uint32_t row) const
+{
+    assert(row < m_Size);
+    return getEntities(row / m_ChunkCapacity)[row % m_ChunkCapacity];
+}
+
+const EntityId* Archetype::getEntities(size_t chunk) const
+{
+    assert(chunk < m_Chunks.size());
+    return reinterpret_cast<const EntityId*>(m_Chunks[chunk]);
+}
+
+size_t Archetype::getChunksCount() const { return (m_Size + m_ChunkCapacity - 1) / m_ChunkCapacity; }
+
+uint32_t Archetype::getChunkSize(size_t chunk) const
+{
+    assert(chunk < getChunksCount());
+    return std::min(m_ChunkCapacity, m_Size - static_cast<uint32_t>(chunk) * m_ChunkCapacity);
+}
+
+uint32_t Archetype::getChunkCapacity() const { return m_ChunkCapacity; }
+uint32_t Archetype::size() const { return m_Size; }
+size_t   Archetype::getAllocatedChunksCount() const { return m_Chunks.size(); }
+
+//==================================================================================================
+// ArchetypeStorage
+//==================================================================================================
+ArchetypeStorage::~ArchetypeStorage()
+{
+    for (Archetype* archetype : m_Archetypes)
+    {
+        delete archetype;
+    }
+}
+
+void ArchetypeStorage::removeEntity(EntityId id)
+{
+    assert(isAlive(id));
+
+    EntityLocation& location = m_Locations[getEntityIndex(id)];
+    onRowMoved(location.archetype->removeRow(location.row), location.row);
+
+    location.archetype = nullptr;
+    releaseIndex(getEntityIndex(id));
+    --m_Size;
+}
+
+bool ArchetypeStorage::isAlive(EntityId id) const
+{
+    uint32_t index = getEntityIndex(id);
+    return index < m_Locations.size() && m_Locations[index].archetype != nullptr && m_Locations[index].id == id;
+}
+
+void ArchetypeStorage::clear()
+{
+    for (Archetype* archetype : m_Archetypes)
+    {
+        archetype->clear();
+    }
+
+    for (size_t index = 1; index < m_Locations.size(); ++index)
+    {
+        if (m_Locations[index].archetype != nullptr)
+        {
+            m_Locations[index].archetype = nullptr;
+            releaseIndex(static_cast<uint32_t>(index));
+        }
+    }
+
+    m_Size = 0;
+}
+
+size_t ArchetypeStorage::size() const { return m_Size; }
+size_t ArchetypeStorage::getArchetypesCount() const { return m_Archetypes.size(); }
+
+EntityId ArchetypeStorage::allocateEntity()
+{
+    uint32_t index = 0;
+    if (!m_FreeIndices.empty())
+    {
+        index = m_FreeIndices.back();
+        m_FreeIndices.pop_back();
+    }
+    else
+    {
+        /* Index 0 is reserved for INVALID_ENTITY_ID */
+        index = static_cast<uint32_t>(std::max<size_t>(m_Locations.size(), 1));
+        assert(index <= MAX_ENTITIES);
+
+        m_Locations.resize(index + 1);
+    }
+
+    EntityLocation& location = m_Locations[index];
+    location.id              = makeEntityId(index, getEntityGeneration(location.id) + 1);
+
+    ++m_Size;
+    return location.id;
+}
+
+void ArchetypeStorage::releaseIndex(uint32_t index)
+{
+    /* The next allocation would wrap the generation around and revive stale handles, so the slot is retired */
+    if (getEntityGeneration(m_Locations[index].id) != MAX_ENTITY_GENERATION)
+    {
+        m_FreeIndices.push_back(index);
+    }
+}
+
+Archetype* ArchetypeStorage::getArchetype(const ComponentSignature& signature, std::vector<ComponentColumnInfo> columns)
+{
+    auto it = m_ArchetypesBySignature.find(signature);
+    if (it != m_ArchetypesBySignature.end())
+    {
+        return it->second;
+    }
+
+    std::sort(columns.begin(), columns.end(), [](const ComponentColumnInfo& lhs, const ComponentColumnInfo& rhs) {
+        return lhs.typeId < rhs.typeId;
+    });
+
+    assert(std::adjacent_find(columns.begin(), columns.end(), [](const auto& lhs, const auto& rhs) {
+               return lhs.typeId == rhs.typeId;
+           }) == columns.end());
+
+    Archetype* archetype = new Archetype(std::move(columns));
+    assert(archetype->getSignature() == signature);
+
+    m_Archetypes.push_back(archetype);
+    m_ArchetypesBySignature.emplace(signature, archetype);
+
+    return archetype;
+}
+
+Archetype* ArchetypeStorage::getAddTransition(Archetype* source, const ComponentColumnInfo& column)
+{
+    Archetype* destination = source->getAddEdge(column.typeId);
+    if (destination == nullptr)
+    {
+        ComponentSignature signature = source->getSignature();
+        signature.set(column.typeId);
+
+        std::vector<ComponentColumnInfo> columns{source->getColumns()};
+        columns.push_back(column);
+
+        destination = getArchetype(signature, std::move(columns));
+        source->setAddEdge(column.typeId, destination);
+        destination->setRemoveEdge(column.typeId, source);
+    }
+
+    return destination;
+}
+
+Archetype* ArchetypeStorage::getRemoveTransition(Archetype* source, ComponentTypeId typeId)
+{
+    Archetype* destination = source->getRemoveEdge(typeId);
+    if (destination == nullptr)
+    {
+        ComponentSignature signature = source->getSignature();
+        signature.reset(typeId);
+
+        std::vector<ComponentColumnInfo> columns;
+        for (const auto& column : source->getColumns())
+        {
+            if (column.typeId != typeId)
+            {
+                columns.push_back(column);
+            }
+        }
+
+        destination = getArchetype(signature, std::move(columns));
+        source->setRemoveEdge(typeId, destination);
+        destination->setAddEdge(typeId, source);
+    }
+
+    return destination;
+}
+
+void ArchetypeStorage::moveEntity(EntityId id, Archetype* destination)
+{
+    EntityLocation& location = m_Locations[getEntityIndex(id)];
+    Archetype*      source   = location.archetype;
+    uint32_t        row      = location.row;
+
+    uint32_t newRow = destination->allocateRow(id);
+
+    const auto& columns = source->getColumns();
+    for (size_t column = 0; column < columns.size(); ++column)
+    {
+        void*   component         = source->getComponent(row, column);
+        int32_t destinationColumn = destination->findColumn(columns[column].typeId);
+
+        if (destinationColumn >= 0)
+        {
+            columns[column].moveConstruct(destination->getComponent(newRow, destinationColumn), component);
+        }
+
+        columns[column].destroy(component);
+    }
+
+    onRowMoved(source->releaseRow(row), row);
+
+    location.archetype = destination;
+    location.row       = newRow;
+}
+
+void ArchetypeStorage::onRowMoved(EntityId movedEntity, uint32_t row)
+{
+    if (movedEntity != INVALID_ENTITY_ID)
+    {
+        m_Locations[getEntityIndex(movedEntity)].row = row;
+    }
+}
@@ -0,0 +1,179 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file command_buffer.cpp
+ * @date 2026-10-16
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ecs/command_buffer.hpp"
+#include <algorithm>
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace gwars;
+
+CommandBuffer::~CommandBuffer()
+{
+    reset();
+
+    for (const Block& block : m_Blocks)
+    {
+        delete[] block.memory;
+    }
+}
+
+EntityId CommandBuffer::createEntity()
+{
+    /* Placeholders are tagged with the generation entities never get, the index part numbers them. More
+     * placeholders than indices means more entities than the manager can hold, so it is fatal. */
+    if (m_PlaceholdersCount > ENTITY_INDEX_MASK)
+    {
+        fprintf(stderr, "CommandBuffer: more than %u entities created before a flush\n", ENTITY_INDEX_MASK + 1);
+        abort();
+    }
+
+    EntityId placeholder = makeEntityId(m_PlaceholdersCount++, PLACEHOLDER_ENTITY_GENERATION);
+
+    Command command;
+    command.type   = CommandType::CreateEntity;
+    command.entity = placeholder;
+
+    m_Commands.push_back(command);
+    return placeholder;
+}
+
+void CommandBuffer::destroyEntity(EntityId id)
+{
+    Command command;
+    command.type   = CommandType::DestroyEntity;
+    command.entity = id;
+
+    m_Commands.push_back(command);
+}
+
+void CommandBuffer::flush(EntityManager& manager)
+{
+    /* Handlers of the events fired while applying commands may record new ones, so the array is walked by index */
+    for (size_t i = 0; i < m_Commands.size(); ++i)
+    {
+        Command command = m_Commands[i];
+
+        if (command.type == CommandType::CreateEntity)
+        {
+            m_CreatedEntities.push_back(manager.createEntity());
+            continue;
+        }
+
+        EntityId entity = resolve(command.entity);
+        if (command.type == CommandType::Instantiate)
+        {
+            command.apply(manager, INVALID_ENTITY_ID, command.payload);
+        }
+        else if (manager.isAlive(entity))
+        {
+            switch (command.type)
+            {
+                case CommandType::DestroyEntity:   { manager.removeEntity(entity); break; }
+                case CommandType::CreateComponent: { command.apply(manager, entity, command.payload); break; }
+                case CommandType::RemoveComponent: { command.apply(manager, entity, nullptr); break; }
+                default:                           { break; }
+            }
+        }
+
+        if (command.destroy != nullptr)
+        {
+            command.destroy(command.payload);
+            m_Commands[i].destroy = nullptr;
+        }
+    }
+
+    reset();
+}
+
+bool CommandBuffer::empty() const { return m_Commands.empty(); }
+
+bool CommandBuffer::isPlaceholder(EntityId id) { return getEntityGeneration(id) == PLACEHOLDER_ENTITY_GENERATION; }
+
+void* CommandBuffer::allocate(size_t size, size_t alignment)
+{
+    for (; m_CurrentBlock < m_Blocks.size(); ++m_CurrentBlock)
+    {
+        Block&    block   = m_Blocks[m_CurrentBlock];
+        uintptr_t address = reinterpret_cast<uintptr_t>(block.memory) + block.used;
+        size_t    padding = (alignment - address % alignment) % alignment;
+
+        if (block.used + padding + size <= block.size)
+        {
+            block.used += padding + size;
+            return block.memory + block.used - size;
+        }
+    }
+
+    /* Blocks are allocated with the default new alignment, so extra space covers larger alignments */
+    Block block;
+    block.size   = std::max(BLOCK_SIZE, size + alignment);
+    block.memory = new uint8_t[block.size];
+    m_Blocks.push_back(block);
+
+    return allocate(size, alignment);
+}
+
+EntityId CommandBuffer::resolve(EntityId id) const
+{
+    if (!isPlaceholder(id))
+    {
+        return id;
+    }
+
+    /* Stale placeholders (kept past a flush) beyond the created entities resolve to no entity, so their
+     * commands are skipped */
+    uint32_t placeholder = getEntityIndex(id);
+    if (placeholder >= m_CreatedEntities.size())
+    {
+        return INVALID_ENTITY_ID;
+    }
+
+    return m_CreatedEntities[placeholder];
+}
+
+void CommandBuffer::reset()
+{
+    for (const Command& command : m_Commands)
+    {
+        if (command.destroy != nullptr)
+        {
+            command.destroy(command.payload);
+        }
+    }
+
+    m_Commands.clear();
+    m_CreatedEntities.clear();
+    m_PlaceholdersCount = 0;
+
+    for (Block& block : m_Blocks)
+    {
+        block.used = 0;
+    }
+
+    m_CurrentBlock = 0;
+}
@@ -1,6 +1,6 @@
 /**
  * @author Nikita Mochalov (github.com/tralf-strues)
- * @file event_sink.cpp
+ * @file component_type.cpp
  * @date 2022-05-23
  * 
  * The MIT License (MIT)
@@ -25,14 +25,15 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
-#include "events/event_sink.hpp"
+#include "ecs/component_type.hpp"
+#include <atomic>
 
 namespace gwars {
 
-uint64_t StaticEventHandlerDelegateIdGenerator::nextId()
+ComponentTypeId ComponentTypeIdGenerator::nextId()
 {
-    static uint64_t s_NextId{1};
+    static std::atomic<ComponentTypeId> s_NextId{1};
     return s_NextId++;
 }
 
-} // namespace gwars
\ No newline at end of file
+} // namespace gwars
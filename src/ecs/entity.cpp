@@ -33,6 +33,9 @@ Entity::Entity(EntityId id, EntityManager& manager) : m_Id(id), m_Manager(&manag
 
 void Entity::destroy() { m_Manager->removeEntity(m_Id); }
 
+EntityId Entity::getId() const { return m_Id; }
+bool     Entity::isAlive() const { return m_Manager != nullptr && m_Manager->isAlive(m_Id); }
+
 bool Entity::operator<(const Entity& other) const { return m_Id < other.m_Id; }
 bool Entity::operator==(const Entity& other) const { return m_Id == other.m_Id; }
 bool Entity::operator!=(const Entity& other) const { return m_Id != other.m_Id; }
\ No newline at end of file
@@ -25,36 +25,473 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include <algorithm>
 #include <cassert>
+#include <cxxabi.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include "ecs/entity_manager.hpp"
 
 using namespace gwars;
 
+EntityManager::~EntityManager()
+{
+    clear();
+
+    for (SparseSet* pool : m_Pools)
+    {
+        delete pool;
+    }
+}
+
 EntityId EntityManager::createEntity()
 {
-    EntityId id = m_NextEntityId++;
-    m_Entities.emplace(id, ComponentMap{});
-    return id;
+    if (m_FreeIndices.empty())
+    {
+        assert(m_Entities.size() <= MAX_ENTITIES);
+
+        const size_t capacity           = m_Entities.capacity();
+        const size_t signaturesCapacity = m_Signatures.capacity();
+
+        EntityId id = makeEntityId(static_cast<uint32_t>(m_Entities.size()), 0);
+        m_Entities.push_back(id);
+        m_Signatures.emplace_back();
+
+        if (m_Entities.capacity() != capacity)
+        {
+            ++m_AllocationsCount;
+        }
+
+        if (m_Signatures.capacity() != signaturesCapacity)
+        {
+            ++m_AllocationsCount;
+        }
+
+        return id;
+    }
+
+    uint32_t index = m_FreeIndices.back();
+    m_FreeIndices.pop_back();
+
+    m_Entities[index] = makeEntityId(index, getEntityGeneration(m_Entities[index]));
+    return m_Entities[index];
+}
+
+size_t EntityManager::createEntities(size_t count)
+{
+    /* Grown geometrically like push_back, an exact reserve would reallocate on every spawn past the capacity */
+    const size_t aliveCount       = m_Entities.size() - 1 - m_FreeIndices.size() - m_RetiredSlotsCount;
+    const size_t slotsCapacity    = m_Entities.capacity() - 1;
+    const size_t requiredCapacity = aliveCount + count;
+    if (requiredCapacity > slotsCapacity)
+    {
+        reserveEntities(std::min(std::max(2 * slotsCapacity, requiredCapacity), static_cast<size_t>(MAX_ENTITIES)));
+    }
+
+    const size_t position = m_SpawnedEntities.size();
+    const size_t capacity = m_SpawnedEntities.capacity();
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        m_SpawnedEntities.push_back(createEntity());
+    }
+
+    if (m_SpawnedEntities.capacity() != capacity)
+    {
+        ++m_AllocationsCount;
+    }
+
+    return position;
+}
+
+const EntityId* EntityManager::getSpawnedEntities(size_t position) const
+{
+    assert(position <= m_SpawnedEntities.size());
+    return m_SpawnedEntities.data() + position;
+}
+
+void EntityManager::popSpawnedEntities(size_t position)
+{
+    assert(position <= m_SpawnedEntities.size());
+    m_SpawnedEntities.resize(position);
 }
 
 void EntityManager::removeEntity(EntityId id)
 {
-    assert(m_Entities.find(id) != m_Entities.end());
+    assert(isAlive(id));
+
+    uint32_t index = getEntityIndex(id);
+
+    /* Remove handlers may add components to the entity, so the signature is re-read after every removal */
+    ComponentTypeId typeId = INVALID_COMPONENT_ID;
+    while ((typeId = m_Signatures[index].first()) != INVALID_COMPONENT_ID)
+    {
+        m_Pools[typeId]->remove(id);
+    }
+
+    releaseSlot(id);
+}
+
+void EntityManager::destroyEntities(const EntityId* ids, size_t idsCount)
+{
+    /* Each entity must be notified about and released exactly once, so dead and repeated ids are dropped */
+    const size_t destroyedCapacity = m_DestroyedEntities.capacity();
+    m_DestroyedEntities.clear();
+
+    for (size_t i = 0; i < idsCount; ++i)
+    {
+        if (isAlive(ids[i]))
+        {
+            m_DestroyedEntities.push_back(ids[i]);
+        }
+    }
+
+    std::sort(m_DestroyedEntities.begin(), m_DestroyedEntities.end());
+    m_DestroyedEntities.erase(std::unique(m_DestroyedEntities.begin(), m_DestroyedEntities.end()),
+                              m_DestroyedEntities.end());
 
-    for (auto [componentTypeId, holder] : m_Entities[id])
+    if (m_DestroyedEntities.capacity() != destroyedCapacity)
     {
-        // IComponentHolder* holderToRemove = &entityMap[id];
-        m_Components[componentTypeId].erase(id);
-        delete holder;
+        ++m_AllocationsCount;
     }
 
-    m_Entities.erase(id);
+    const EntityId* entities = m_DestroyedEntities.data();
+    const size_t    count    = m_DestroyedEntities.size();
+
+    ComponentSignature affectedTypes;
+    for (size_t i = 0; i < count; ++i)
+    {
+        affectedTypes.merge(m_Signatures[getEntityIndex(entities[i])]);
+    }
+
+    /* All notifications go first, so that handlers still see every component of the batch */
+    ComponentTypeId typeId = INVALID_COMPONENT_ID;
+    while ((typeId = affectedTypes.first()) != INVALID_COMPONENT_ID)
+    {
+        affectedTypes.reset(typeId);
+
+        const size_t capacity = m_BatchEntities.capacity();
+        m_BatchEntities.clear();
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (m_Signatures[getEntityIndex(entities[i])].test(typeId))
+            {
+                m_BatchEntities.push_back(entities[i]);
+            }
+        }
+
+        if (m_BatchEntities.capacity() != capacity)
+        {
+            ++m_AllocationsCount;
+        }
+
+        m_Pools[typeId]->fireRemoveBatch(m_BatchEntities.data(), m_BatchEntities.size());
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const ComponentSignature& signature = m_Signatures[getEntityIndex(entities[i])];
+        while ((typeId = signature.first()) != INVALID_COMPONENT_ID)
+        {
+            m_Pools[typeId]->release(entities[i]);
+        }
+
+        releaseSlot(entities[i]);
+    }
+}
+
+const ComponentSignature& EntityManager::getSignature(EntityId id) const
+{
+    assert(isAlive(id));
+    return m_Signatures[getEntityIndex(id)];
+}
+
+bool EntityManager::isAlive(EntityId id) const
+{
+    uint32_t index = getEntityIndex(id);
+    return index != 0 && index < m_Entities.size() && m_Entities[index] == id;
 }
 
 void EntityManager::clear()
 {
-    for (auto [entityId, componentMap] : m_Entities)
+    /* All notifications go first, so that handlers still see every component */
+    for (SparseSet* pool : m_Pools)
+    {
+        if (pool != nullptr)
+        {
+            pool->fireRemoveBatch(pool->getEntities(), pool->size());
+        }
+    }
+
+    for (SparseSet* pool : m_Pools)
+    {
+        if (pool != nullptr)
+        {
+            pool->clear();
+        }
+    }
+
+    const size_t capacity = m_FreeIndices.capacity();
+
+    /* Every slot but the retired ones becomes free, pushed in reverse order, so that slots are reused from
+     * the lowest index */
+    m_FreeIndices.clear();
+    for (uint32_t index = static_cast<uint32_t>(m_Entities.size()) - 1; index > 0; --index)
+    {
+        EntityId slot = m_Entities[index];
+        if (slot == INVALID_ENTITY_ID)
+        {
+            continue;
+        }
+
+        if (getEntityIndex(slot) == index)
+        {
+            if (getEntityGeneration(slot) == MAX_ENTITY_GENERATION)
+            {
+                m_Entities[index] = INVALID_ENTITY_ID;
+                ++m_RetiredSlotsCount;
+                continue;
+            }
+
+            m_Entities[index] = makeEntityId(0, getEntityGeneration(slot) + 1);
+        }
+
+        m_FreeIndices.push_back(index);
+    }
+
+    if (m_FreeIndices.capacity() != capacity)
     {
-        removeEntity(entityId);
+        ++m_AllocationsCount;
     }
-}
\ No newline at end of file
+}
+
+void EntityManager::saveEntities(BinaryWriter& writer) const
+{
+    writer.writeValue<uint64_t>(m_Entities.size());
+    writer.writeBlock(m_Entities.data(), m_Entities.size() * sizeof(EntityId), alignof(EntityId));
+
+    writer.writeValue<uint64_t>(m_FreeIndices.size());
+    writer.writeBlock(m_FreeIndices.data(), m_FreeIndices.size() * sizeof(uint32_t), alignof(uint32_t));
+}
+
+bool EntityManager::loadEntities(BinaryReader& reader)
+{
+#ifndef NDEBUG
+    for (const ComponentSignature& signature : m_Signatures)
+    {
+        assert(!signature.any());
+    }
+#endif
+
+    uint64_t        slotsCount = reader.readValue<uint64_t>();
+    const EntityId* slots      = static_cast<const EntityId*>(
+        reader.readArray(slotsCount, sizeof(EntityId), alignof(EntityId)));
+
+    uint64_t        freeCount   = reader.readValue<uint64_t>();
+    const uint32_t* freeIndices = static_cast<const uint32_t*>(
+        reader.readArray(freeCount, sizeof(uint32_t), alignof(uint32_t)));
+
+    if (reader.isFailed() || slotsCount == 0 || slotsCount > MAX_ENTITIES + 1 || freeCount >= slotsCount
+        || !isValidSlots(slots, slotsCount, freeIndices, freeCount))
+    {
+        return false;
+    }
+
+    reserveEntities(slotsCount - 1);
+
+    m_Entities.assign(slots, slots + slotsCount);
+    m_FreeIndices.assign(freeIndices, freeIndices + freeCount);
+    m_Signatures.assign(slotsCount, ComponentSignature{});
+
+    m_RetiredSlotsCount = 0;
+    for (size_t index = 1; index < slotsCount; ++index)
+    {
+        if (slots[index] == INVALID_ENTITY_ID)
+        {
+            ++m_RetiredSlotsCount;
+        }
+    }
+
+    return true;
+}
+
+/* Slot 0 is reserved, every other slot holds either its alive entity, a free slot's next generation (with
+ * index 0) or INVALID_ENTITY_ID for a retired slot, placeholders' generation is never used. The free list
+ * must hold exactly the free slots, each once, or slots would be handed out twice. */
+bool EntityManager::isValidSlots(const EntityId* slots,
+                                 size_t          slotsCount,
+                                 const uint32_t* freeIndices,
+                                 size_t          freeCount)
+{
+    if (slots[0] != INVALID_ENTITY_ID)
+    {
+        return false;
+    }
+
+    std::vector<bool> listed(slotsCount, false);
+    for (size_t i = 0; i < freeCount; ++i)
+    {
+        uint32_t index = freeIndices[i];
+        if (index == 0 || index >= slotsCount || listed[index] || getEntityIndex(slots[index]) != 0
+            || slots[index] == INVALID_ENTITY_ID)
+        {
+            return false;
+        }
+
+        listed[index] = true;
+    }
+
+    for (size_t index = 1; index < slotsCount; ++index)
+    {
+        uint32_t slotIndex = getEntityIndex(slots[index]);
+        if ((slotIndex == 0 && slots[index] != INVALID_ENTITY_ID && !listed[index])
+            || (slotIndex != 0 && slotIndex != index) || getEntityGeneration(slots[index]) > MAX_ENTITY_GENERATION)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void EntityManager::reserveEntities(size_t capacity)
+{
+    assert(capacity <= MAX_ENTITIES);
+
+    /* Slot 0 is reserved, and the free list may have to hold every slot */
+    if (m_Entities.capacity() < capacity + 1)
+    {
+        m_Entities.reserve(capacity + 1);
+        m_Signatures.reserve(capacity + 1);
+        m_AllocationsCount += 2;
+    }
+
+    if (m_FreeIndices.capacity() < capacity)
+    {
+        m_FreeIndices.reserve(capacity);
+        ++m_AllocationsCount;
+    }
+}
+
+void EntityManager::releaseSlot(EntityId id)
+{
+    uint32_t index = getEntityIndex(id);
+    assert(!m_Signatures[index].any());
+
+    /* Reusing the slot would wrap its generation around and revive stale handles, so it is retired for good */
+    if (getEntityGeneration(id) == MAX_ENTITY_GENERATION)
+    {
+        m_Entities[index] = INVALID_ENTITY_ID;
+        ++m_RetiredSlotsCount;
+        return;
+    }
+
+    m_Entities[index] = makeEntityId(0, getEntityGeneration(id) + 1);
+
+    const size_t capacity = m_FreeIndices.capacity();
+    m_FreeIndices.push_back(index);
+
+    if (m_FreeIndices.capacity() != capacity)
+    {
+        ++m_AllocationsCount;
+    }
+}
+
+size_t EntityManager::getAllocationsCount() const
+{
+    size_t allocationsCount = m_AllocationsCount;
+    for (const SparseSet* pool : m_Pools)
+    {
+        if (pool != nullptr)
+        {
+            allocationsCount += pool->getAllocationsCount();
+        }
+    }
+
+    return allocationsCount;
+}
+
+EntityManagerStats EntityManager::getStats() const
+{
+    EntityManagerStats stats;
+    stats.slotsCount            = m_Entities.size() - 1;
+    stats.entitiesCount         = stats.slotsCount - m_FreeIndices.size() - m_RetiredSlotsCount;
+    stats.slotsCapacity         = m_Entities.capacity() - 1;
+    stats.bytesPerEntity        = sizeof(EntityId) + sizeof(ComponentSignature);
+    stats.entitiesBytesReserved = m_Entities.capacity() * sizeof(EntityId)
+                                  + m_Signatures.capacity() * sizeof(ComponentSignature)
+                                  + m_FreeIndices.capacity() * sizeof(uint32_t)
+                                  + m_SpawnedEntities.capacity() * sizeof(EntityId)
+                                  + m_Pools.capacity() * sizeof(SparseSet*);
+    stats.allocationsCount      = getAllocationsCount();
+    stats.frameAllocationsCount = stats.allocationsCount - m_FrameAllocationsBase;
+    stats.eventSinksCount       = m_EventDispatcher.getSinksCount();
+    stats.eventHandlersCount    = m_EventDispatcher.getHandlersCount();
+
+    for (const SparseSet* pool : m_Pools)
+    {
+        if (pool != nullptr)
+        {
+            stats.pools.push_back(pool->getStats());
+        }
+    }
+
+    return stats;
+}
+
+void EntityManager::printStats() const
+{
+    EntityManagerStats stats = getStats();
+
+    printf("Entities: %zu alive, %zu slots (high-water mark), %zu reserved, %zu bytes per entity, %zu bytes\n",
+           stats.entitiesCount,
+           stats.slotsCount,
+           stats.slotsCapacity,
+           stats.bytesPerEntity,
+           stats.entitiesBytesReserved);
+
+    printf("Allocations: %zu total, %zu this frame\n", stats.allocationsCount, stats.frameAllocationsCount);
+    printf("Event sinks: %zu, handlers: %zu\n", stats.eventSinksCount, stats.eventHandlersCount);
+
+    printf("%-32s %8s %8s %8s %12s %12s %8s %8s\n",
+           "Component",
+           "Count",
+           "Capacity",
+           "Peak",
+           "Used, B",
+           "Reserved, B",
+           "Allocs",
+           "Frame");
+
+    for (const ComponentPoolStats& pool : stats.pools)
+    {
+        int   status    = 0;
+        char* demangled = abi::__cxa_demangle(pool.typeName, nullptr, nullptr, &status);
+
+        printf("%-32s %8zu %8zu %8zu %12zu %12zu %8zu %8zu\n",
+               status == 0 ? demangled : pool.typeName,
+               pool.count,
+               pool.capacity,
+               pool.highWaterMark,
+               pool.bytesUsed,
+               pool.bytesReserved,
+               pool.allocationsCount,
+               pool.frameAllocationsCount);
+
+        free(demangled);
+    }
+}
+
+void EntityManager::resetFrameStats()
+{
+    m_FrameAllocationsBase = getAllocationsCount();
+
+    for (SparseSet* pool : m_Pools)
+    {
+        if (pool != nullptr)
+        {
+            pool->resetFrameStats();
+        }
+    }
+}
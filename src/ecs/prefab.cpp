@@ -0,0 +1,52 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file prefab.cpp
+ * @date 2026-10-16
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "ecs/prefab.hpp"
+
+using namespace gwars;
+
+Prefab::~Prefab()
+{
+    for (const ComponentPrototype& prototype : m_Prototypes)
+    {
+        prototype.destroy(prototype.prototype);
+    }
+}
+
+void Prefab::instantiate(EntityManager& manager, const EntityId* entities, size_t count) const
+{
+    for (const ComponentPrototype& prototype : m_Prototypes)
+    {
+        prototype.instantiate(manager, entities, count, prototype.prototype);
+    }
+}
+
+void gwars::instantiate(EntityManager& manager, const Prefab& prefab, size_t count)
+{
+    instantiate(manager, prefab, count, [](Entity, size_t) {});
+}
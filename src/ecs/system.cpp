@@ -0,0 +1,71 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file system.cpp
+ * @date 2026-10-16
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "ecs/system.hpp"
+
+using namespace gwars;
+
+SystemAccess& SystemAccess::exclusive()
+{
+    m_Exclusive = true;
+    return *this;
+}
+
+bool SystemAccess::isExclusive() const { return m_Exclusive; }
+
+bool SystemAccess::conflictsWith(const SystemAccess& other) const
+{
+    if (m_Exclusive || other.m_Exclusive)
+    {
+        return true;
+    }
+
+    return intersect(m_Writes, other.m_Writes) || intersect(m_Writes, other.m_Reads)
+           || intersect(m_Reads, other.m_Writes);
+}
+
+void SystemAccess::createPools(EntityManager& manager) const
+{
+    for (CreatePoolFunction createPool : m_CreatePoolFunctions)
+    {
+        createPool(manager);
+    }
+}
+
+bool SystemAccess::intersect(const std::vector<ComponentTypeId>& first, const std::vector<ComponentTypeId>& second)
+{
+    for (ComponentTypeId typeId : first)
+    {
+        if (std::find(second.begin(), second.end(), typeId) != second.end())
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
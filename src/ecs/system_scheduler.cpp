@@ -0,0 +1,174 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file system_scheduler.cpp
+ * @date 2026-10-16
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "ecs/system_scheduler.hpp"
+#include <cassert>
+
+using namespace gwars;
+
+SystemScheduler::SystemScheduler(EntityManager& manager, size_t threadsCount)
+    : m_Manager(manager), m_ThreadPool(threadsCount)
+{
+}
+
+SystemScheduler::~SystemScheduler()
+{
+    for (Node* node : m_Nodes)
+    {
+        delete node->system;
+        delete node;
+    }
+}
+
+void SystemScheduler::addSystem(ISystem* system)
+{
+    assert(system != nullptr);
+
+    Node* node      = new Node();
+    node->scheduler = this;
+    node->system    = system;
+    system->declareAccess(node->access);
+
+    m_Nodes.push_back(node);
+    m_GraphBuilt = false;
+}
+
+void SystemScheduler::run(float dt)
+{
+    if (!m_GraphBuilt)
+    {
+        buildGraph();
+    }
+
+    size_t begin = 0;
+    while (begin < m_Nodes.size())
+    {
+        if (m_Nodes[begin]->access.isExclusive())
+        {
+            m_Nodes[begin]->system->onUpdate(dt);
+            ++begin;
+            continue;
+        }
+
+        size_t end = begin + 1;
+        while (end < m_Nodes.size() && !m_Nodes[end]->access.isExclusive())
+        {
+            ++end;
+        }
+
+        runSegment(begin, end, dt);
+        begin = end;
+    }
+}
+
+void SystemScheduler::buildGraph()
+{
+    /* Systems before an exclusive one are always finished by the time the next segment starts, so
+     * dependencies are only tracked within segments */
+    size_t segmentBegin = 0;
+    for (size_t i = 0; i < m_Nodes.size(); ++i)
+    {
+        Node* node = m_Nodes[i];
+        node->dependents.clear();
+        node->dependenciesCount = 0;
+        node->access.createPools(m_Manager);
+
+        if (node->access.isExclusive())
+        {
+            segmentBegin = i + 1;
+            continue;
+        }
+
+        for (size_t j = segmentBegin; j < i; ++j)
+        {
+            if (m_Nodes[j]->access.conflictsWith(node->access))
+            {
+                m_Nodes[j]->dependents.push_back(i);
+                ++node->dependenciesCount;
+            }
+        }
+    }
+
+    m_GraphBuilt = true;
+}
+
+void SystemScheduler::runSegment(size_t begin, size_t end, float dt)
+{
+    if (end - begin == 1 || m_ThreadPool.getThreadsCount() == 0)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            m_Nodes[i]->system->onUpdate(dt);
+        }
+
+        return;
+    }
+
+    m_DeltaTime = dt;
+    m_PendingCount.store(end - begin);
+
+    for (size_t i = begin; i < end; ++i)
+    {
+        m_Nodes[i]->remainingDependencies.store(m_Nodes[i]->dependenciesCount);
+    }
+
+    for (size_t i = begin; i < end; ++i)
+    {
+        if (m_Nodes[i]->dependenciesCount == 0)
+        {
+            m_ThreadPool.submit(&SystemScheduler::runNode, m_Nodes[i]);
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_SegmentFinished.wait(lock, [this]() { return m_PendingCount.load() == 0; });
+}
+
+void SystemScheduler::runNode(void* data)
+{
+    Node*            node      = static_cast<Node*>(data);
+    SystemScheduler* scheduler = node->scheduler;
+
+    node->system->onUpdate(scheduler->m_DeltaTime);
+
+    for (size_t dependent : node->dependents)
+    {
+        Node* dependentNode = scheduler->m_Nodes[dependent];
+        if (dependentNode->remainingDependencies.fetch_sub(1) == 1)
+        {
+            scheduler->m_ThreadPool.submit(&SystemScheduler::runNode, dependentNode);
+        }
+    }
+
+    /* Notifying under the lock, so that the waiting thread can't miss the wakeup */
+    if (scheduler->m_PendingCount.fetch_sub(1) == 1)
+    {
+        std::lock_guard<std::mutex> lock(scheduler->m_Mutex);
+        scheduler->m_SegmentFinished.notify_one();
+    }
+}
@@ -0,0 +1,97 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file connection.cpp
+ * @date 2026-10-17
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "events/connection.hpp"
+#include <utility>
+
+namespace gwars {
+
+//==================================================================================================
+// Connection
+//==================================================================================================
+Connection::Connection(IHandlerList* list, HandlerId handlerId) : m_List(list), m_HandlerId(handlerId) {}
+
+Connection::Connection(Connection&& other) : m_List(other.m_List), m_HandlerId(other.m_HandlerId)
+{
+    other.m_List = nullptr;
+}
+
+/* Doesn't disconnect the overwritten connection, that's what ScopedConnection is for */
+Connection& Connection::operator=(Connection&& other)
+{
+    if (this != &other)
+    {
+        m_List       = other.m_List;
+        m_HandlerId  = other.m_HandlerId;
+        other.m_List = nullptr;
+    }
+
+    return *this;
+}
+
+void Connection::disconnect()
+{
+    if (m_List != nullptr)
+    {
+        m_List->remove(m_HandlerId);
+        m_List = nullptr;
+    }
+}
+
+bool Connection::isConnected() const { return m_List != nullptr; }
+
+//==================================================================================================
+// ScopedConnection
+//==================================================================================================
+ScopedConnection::ScopedConnection(Connection&& connection) : m_Connection(std::move(connection)) {}
+
+ScopedConnection::~ScopedConnection() { disconnect(); }
+
+ScopedConnection::ScopedConnection(ScopedConnection&& other) : m_Connection(other.release()) {}
+
+ScopedConnection& ScopedConnection::operator=(ScopedConnection&& other)
+{
+    if (this != &other)
+    {
+        disconnect();
+        m_Connection = other.release();
+    }
+
+    return *this;
+}
+
+void ScopedConnection::disconnect() { m_Connection.disconnect(); }
+
+bool ScopedConnection::isConnected() const { return m_Connection.isConnected(); }
+
+Connection ScopedConnection::release()
+{
+    return std::move(m_Connection);
+}
+
+} // namespace gwars
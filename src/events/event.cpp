@@ -26,13 +26,15 @@
  */
 
 #include "events/event.hpp"
+#include <atomic>
 
 namespace gwars {
 
 EventType StaticEventTypeGenerator::nextEventType()
 {
-    static EventType s_NextEventType{1};
-    return s_NextEventType++;
+    /* Event types may be first used on different threads at once */
+    static std::atomic<EventType> s_NextEventType{1};
+    return s_NextEventType.fetch_add(1, std::memory_order_relaxed);
 }
 
 } // namespace gwars
\ No newline at end of file
@@ -27,14 +27,148 @@
 
 #include "events/event_dispatcher.hpp"
 
+#ifdef GWARS_EVENT_PROFILING
+#include <algorithm>
+#include <cxxabi.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#endif
+
 namespace gwars {
 
 EventDispatcher::~EventDispatcher()
 {
-    for (auto [eventType, sink] : m_Sinks)
+    for (IEventSink* sink : m_Sinks)
     {
         delete sink;
     }
 }
 
+void EventDispatcher::dispatchQueued()
+{
+    for (IEventSink* sink : m_PostingSinks)
+    {
+        if (sink->drainPosted())
+        {
+            m_QueuedSinks.push_back(sink);
+        }
+    }
+
+    /* Handlers may enqueue more events, which appends sinks to the list */
+    for (size_t i = 0; i < m_QueuedSinks.size(); ++i)
+    {
+        m_QueuedSinks[i]->dispatchQueued();
+    }
+
+    m_QueuedSinks.clear();
+}
+
+size_t EventDispatcher::getSinksCount() const
+{
+    size_t sinksCount = 0;
+    for (const IEventSink* sink : m_Sinks)
+    {
+        if (sink != nullptr)
+        {
+            ++sinksCount;
+        }
+    }
+
+    return sinksCount;
+}
+
+size_t EventDispatcher::getHandlersCount() const
+{
+    size_t handlersCount = 0;
+    for (const IEventSink* sink : m_Sinks)
+    {
+        if (sink != nullptr)
+        {
+            handlersCount += sink->getHandlersCount();
+        }
+    }
+
+    return handlersCount;
+}
+
+#ifdef GWARS_EVENT_PROFILING
+/* Cuts the handler out of getHandlerName's "... [with auto HandlerT = &Class::method]" */
+static void printHandlerName(const char* prettyFunction)
+{
+    const char* nameBegin = strstr(prettyFunction, "HandlerT = ");
+    if (nameBegin == nullptr)
+    {
+        printf("%-48s", prettyFunction);
+        return;
+    }
+
+    nameBegin += strlen("HandlerT = ");
+    int nameLength = static_cast<int>(strcspn(nameBegin, ";]"));
+
+    printf("%-48.*s", nameLength, nameBegin);
+}
+
+void EventDispatcher::printProfile() const
+{
+    std::vector<EventHandlerProfile> profiles;
+    for (const IEventSink* sink : m_Sinks)
+    {
+        if (sink != nullptr)
+        {
+            sink->collectProfile(profiles);
+        }
+    }
+
+    std::sort(profiles.begin(),
+              profiles.end(),
+              [](const EventHandlerProfile& first, const EventHandlerProfile& second) {
+                  return first.totalNanoseconds > second.totalNanoseconds;
+              });
+
+    printf("%-32s %-48s %8s %8s %8s %12s %10s %10s\n",
+           "Event",
+           "Handler",
+           "Handlers",
+           "Fired",
+           "Calls",
+           "Total, ms",
+           "Avg, ns",
+           "Max, ns");
+
+    for (const EventHandlerProfile& profile : profiles)
+    {
+        int   status    = 0;
+        char* demangled = abi::__cxa_demangle(profile.eventTypeName, nullptr, nullptr, &status);
+
+        printf("%-32s ", status == 0 ? demangled : profile.eventTypeName);
+        printHandlerName(profile.handlerName);
+        printf(" %8zu %8llu %8llu %12.3f %10llu %10llu\n",
+               profile.handlersCount,
+               static_cast<unsigned long long>(profile.firedCount),
+               static_cast<unsigned long long>(profile.callsCount),
+               static_cast<double>(profile.totalNanoseconds) / 1e6,
+               static_cast<unsigned long long>(profile.callsCount > 0 ? profile.totalNanoseconds / profile.callsCount
+                                                                      : 0),
+               static_cast<unsigned long long>(profile.maxNanoseconds));
+
+        free(demangled);
+    }
+}
+
+void EventDispatcher::resetProfile()
+{
+    for (IEventSink* sink : m_Sinks)
+    {
+        if (sink != nullptr)
+        {
+            sink->resetProfile();
+        }
+    }
+}
+#else
+void EventDispatcher::printProfile() const {}
+void EventDispatcher::resetProfile() {}
+#endif
+
 } // namespace gwars
\ No newline at end of file
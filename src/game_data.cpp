@@ -36,6 +36,10 @@ namespace gwars {
 //==================================================================================================
 const Polygon SPACESHIP_MODEL            = loadPolygon("assets/player_spaceship.txt");
 const Polygon SPACESHIP_PROJECTILE_MODEL = loadPolygon("assets/player_spaceship_projectile.txt");
+const Polygon FIRE_PARTICLE_MODEL        = loadPolygon("assets/fire_particle.txt");
+
+const size_t ENTITIES_RESERVED  = 1024;
+const float  STATS_PRINT_PERIOD = 60;
 
 const Vec2f SPACESHIP_SCALE                      = Vec2f(15, 15);
 const Vec2f SPACESHIP_FORWARD                    = Vec2f(0, 1);
@@ -70,18 +74,42 @@ const float   UFO_BOUNDING_SPHERE_RADIUS      = sqrtf(1.73);
 
 const Score UFO_SCORE = 10;
 
+/* Scripts refer to the player by id, which a corrupted snapshot may point anywhere */
+static bool loadPlayer(BinaryReader& reader, Scene& scene, Entity& player)
+{
+    player = scene.getEntity(reader.readValue<EntityId>());
+    return !reader.isFailed() && player.isAlive() && player.hasComponent<TransformComponent>()
+           && player.hasComponent<BoundingSphereComponent>();
+}
+
 //==================================================================================================
 // PlayerControlScript
 //==================================================================================================
+PlayerControlScript::PlayerControlScript(Scene& scene) : m_Scene(scene)
+{
+    m_ProjectilePrefab.add<TransformComponent>()
+        .add<WorldTransformComponent>()
+        .add<GWarsEntityComponent>(GWarsEntityComponent::EntityType::SpaceshipProjectile)
+        .add<PolygonComponent>(SPACESHIP_PROJECTILE_MODEL)
+        .add<PhysicsComponent>()
+        .add<BoundingSphereComponent>(SPACESHIP_PROJECTILE_BOUNDING_SPHERE_RADIUS,
+                                      SPACESHIP_PROJECTILE_BOUNDING_SPHERE_TRANSLATION,
+                                      getCollisionLayer(GWarsEntityComponent::EntityType::SpaceshipProjectile));
+}
+
 void PlayerControlScript::onAttach(Entity entity, EventDispatcher& eventDispatcher)
 {
     m_Entity = entity;
-    eventDispatcher.getSink<KeyPressedEvent>().addHandler<&PlayerControlScript::onKeyPressed>(*this);
-    eventDispatcher.getSink<KeyReleasedEvent>().addHandler<&PlayerControlScript::onKeyReleased>(*this);
-    eventDispatcher.getSink<MouseMoveEvent>().addHandler<&PlayerControlScript::onMouseMoved>(*this);
-    eventDispatcher.getSink<MouseButtonPressedEvent>().addHandler<&PlayerControlScript::onMouseButtonPressed>(*this);
-    eventDispatcher.getSink<MouseButtonReleasedEvent>().addHandler<&PlayerControlScript::onMouseButtonReleased>(*this);
-    eventDispatcher.getSink<EnemyKilledEvent>().addHandler<&PlayerControlScript::onEnemyKilledEvent>(*this);
+    m_Connections.emplace_back(
+        eventDispatcher.getSink<MouseMoveEvent>().addHandler<&PlayerControlScript::onMouseMoved>(*this));
+    m_Connections.emplace_back(
+        eventDispatcher.getSink<MouseButtonPressedEvent>().addHandler<&PlayerControlScript::onMouseButtonPressed>(
+            *this));
+    m_Connections.emplace_back(
+        eventDispatcher.getSink<MouseButtonReleasedEvent>().addHandler<&PlayerControlScript::onMouseButtonReleased>(
+            *this));
+    m_Connections.emplace_back(
+        eventDispatcher.getSink<EnemyKilledEvent>().addHandler<&PlayerControlScript::onEnemyKilledEvent>(*this));
 
     m_ParticleSpecs.colorBegin = Vec4f(0.05f, 0.2f, 0.8f, 1.0f);
     m_ParticleSpecs.colorEnd = Vec4f(0.2f, 0.6f, 0.8f, 0.0f);
@@ -93,28 +121,19 @@ void PlayerControlScript::onAttach(Entity entity, EventDispatcher& eventDispatch
     m_ParticleSpecs.lifetime = 0.2f;
 }
 
-void PlayerControlScript::onDetach(Entity, EventDispatcher& eventDispatcher)
-{
-    /* TODO: Make a convenience function in event dispatcher */
-    eventDispatcher.getSink<KeyPressedEvent>().removeHandler<&PlayerControlScript::onKeyPressed>(*this);
-    eventDispatcher.getSink<KeyReleasedEvent>().removeHandler<&PlayerControlScript::onKeyReleased>(*this);
-    eventDispatcher.getSink<MouseMoveEvent>().removeHandler<&PlayerControlScript::onMouseMoved>(*this);
-    eventDispatcher.getSink<MouseButtonPressedEvent>().removeHandler<&PlayerControlScript::onMouseButtonPressed>(*this);
-    eventDispatcher.getSink<MouseButtonReleasedEvent>().removeHandler<&PlayerControlScript::onMouseButtonReleased>(
-        *this);
-    eventDispatcher.getSink<EnemyKilledEvent>().removeHandler<&PlayerControlScript::onEnemyKilledEvent>(*this);
-}
+void PlayerControlScript::onDetach(Entity, EventDispatcher&) { m_Connections.clear(); }
 
 void PlayerControlScript::onUpdate(float dt)
 {
-    assert(m_Entity.hasComponent<TransformComponent>());
+    assert(m_Entity.hasComponent<WorldTransformComponent>());
 
-    const TransformComponent& transformComponent = m_Entity.getComponent<TransformComponent>();
+    const WorldTransformComponent& worldTransform = m_Entity.getComponent<const WorldTransformComponent>();
 
     PhysicsComponent& physicsComponent = m_Entity.getComponent<PhysicsComponent>();
     Vec2f             forward          = calculateForward();
     Vec2f             right            = perpendicularCounterClockwise(-forward);
-    Vec2f             engineForce      = forward * m_EngineForce.y + right * m_EngineForce.x;
+    Vec2f             localForce       = calculateEngineForce();
+    Vec2f             engineForce      = forward * localForce.y + right * localForce.x;
 
     Vec2f frictionForce = (lengthSquare(engineForce) == 0)
                               ? -physicsComponent.mass * SPACESHIP_FRICTION * physicsComponent.velocity
@@ -125,9 +144,8 @@ void PlayerControlScript::onUpdate(float dt)
     m_ParticleSpecs.velocity = -forward * (length(physicsComponent.velocity) + 100.0f);
     m_ParticleSpecs.velocityVariation = 30.0f * right + 100.0f * forward;
 
-    Mat3f transformMatrix = transformComponent.calculateMatrix();
-    emit(transformMatrix * Vec3f(SPACESHIP_LEFT_REACTOR_POSITION, 1));
-    emit(transformMatrix * Vec3f(SPACESHIP_RIGHT_REACTOR_POSITION, 1));
+    emit(worldTransform.matrix * Vec3f(SPACESHIP_LEFT_REACTOR_POSITION, 1));
+    emit(worldTransform.matrix * Vec3f(SPACESHIP_RIGHT_REACTOR_POSITION, 1));
 
     if (m_Shooting && m_Recharge <= 0)
     {
@@ -141,18 +159,25 @@ void PlayerControlScript::onUpdate(float dt)
     }
 }
 
+uint32_t PlayerControlScript::getType() const { return static_cast<uint32_t>(ScriptType::PlayerControl); }
+
+/* Engine force and shooting state are driven by input, so only the recharge timer is saved */
+void PlayerControlScript::save(BinaryWriter& writer) const { writer.writeValue(m_Recharge); }
+bool PlayerControlScript::load(BinaryReader& reader, Scene&)
+{
+    m_Recharge = reader.readValue<float>();
+    return true;
+}
+
 void PlayerControlScript::shoot(Vec2f position, Vec2f velocity)
 {
-    TransformComponent transform{m_Entity.getComponent<TransformComponent>()};
-    transform.translation = transform.calculateMatrix() * Vec3f(position, 1);
-
-    Entity projectile = m_Scene.createEntity();
-    projectile.createComponent<TransformComponent>(transform);
-    projectile.createComponent<GWarsEntityComponent>(GWarsEntityComponent::EntityType::SpaceshipProjectile);
-    projectile.createComponent<PolygonComponent>(SPACESHIP_PROJECTILE_MODEL);
-    projectile.createComponent<PhysicsComponent>(velocity);
-    projectile.createComponent<BoundingSphereComponent>(SPACESHIP_PROJECTILE_BOUNDING_SPHERE_RADIUS,
-                                                        SPACESHIP_PROJECTILE_BOUNDING_SPHERE_TRANSLATION);
+    TransformComponent transform{m_Entity.getComponent<const TransformComponent>()};
+    transform.translation = m_Entity.getComponent<const WorldTransformComponent>().matrix * Vec3f(position, 1);
+
+    m_Scene.getCommandBuffer().instantiate(m_ProjectilePrefab, 1, [transform, velocity](Entity projectile, size_t) {
+        projectile.getComponent<TransformComponent>()        = transform;
+        projectile.getComponent<PhysicsComponent>().velocity = velocity;
+    });
 }
 
 void PlayerControlScript::emit(Vec2f position)
@@ -168,31 +193,36 @@ void PlayerControlScript::emit(Vec2f position)
 
 Vec2f PlayerControlScript::calculateForward()
 {
-    return m_Entity.getComponent<TransformComponent>().calculateRotationMatrix() * Vec3f(SPACESHIP_FORWARD, 1);
+    return m_Entity.getComponent<const TransformComponent>().calculateRotationMatrix() * Vec3f(SPACESHIP_FORWARD, 1);
 }
 
-void PlayerControlScript::onKeyPressed(const KeyPressedEvent& event)
+/* Derived from the held keys rather than accumulated from press/release events, so that keys held while
+ * the script is recreated (on restart or snapshot load) don't leave a stale force behind */
+Vec2f PlayerControlScript::calculateEngineForce() const
 {
-    switch (event.key)
+    Vec2f engineForce(0, 0);
+
+    if (isKeyPressed(Key::Left))
     {
-        case Key::Left:  { m_EngineForce.x -= SPACESHIP_PERPENDICULAR_ENGINE_FORCE; break; }
-        case Key::Right: { m_EngineForce.x += SPACESHIP_PERPENDICULAR_ENGINE_FORCE; break; }
-        case Key::Down:  { m_EngineForce.y -= SPACESHIP_FORWARD_ENGINE_FORCE; break; }
-        case Key::Up:    { m_EngineForce.y += SPACESHIP_FORWARD_ENGINE_FORCE; break; }
-        default:         { break; }
+        engineForce.x -= SPACESHIP_PERPENDICULAR_ENGINE_FORCE;
     }
-}
 
-void PlayerControlScript::onKeyReleased(const KeyReleasedEvent& event)
-{
-    switch (event.key)
+    if (isKeyPressed(Key::Right))
+    {
+        engineForce.x += SPACESHIP_PERPENDICULAR_ENGINE_FORCE;
+    }
+
+    if (isKeyPressed(Key::Down))
     {
-        case Key::Left:  { m_EngineForce.x += SPACESHIP_PERPENDICULAR_ENGINE_FORCE; break; }
-        case Key::Right: { m_EngineForce.x -= SPACESHIP_PERPENDICULAR_ENGINE_FORCE; break; }
-        case Key::Down:  { m_EngineForce.y += SPACESHIP_FORWARD_ENGINE_FORCE; break; }
-        case Key::Up:    { m_EngineForce.y -= SPACESHIP_FORWARD_ENGINE_FORCE; break; }
-        default:         { break; }
+        engineForce.y -= SPACESHIP_FORWARD_ENGINE_FORCE;
     }
+
+    if (isKeyPressed(Key::Up))
+    {
+        engineForce.y += SPACESHIP_FORWARD_ENGINE_FORCE;
+    }
+
+    return engineForce;
 }
 
 void PlayerControlScript::onMouseMoved(const MouseMoveEvent& event)
@@ -201,8 +231,8 @@ void PlayerControlScript::onMouseMoved(const MouseMoveEvent& event)
 
     Entity mainCamera = m_Scene.getMainCamera();
 
-    Vec2f world = mainCamera.getComponent<TransformComponent>().calculateMatrix()
-                  * mainCamera.getComponent<CameraComponent>().cameraSpecs.calculateInverseProjectionMatrix()
+    Vec2f world = mainCamera.getComponent<const WorldTransformComponent>().matrix
+                  * mainCamera.getComponent<const CameraComponent>().cameraSpecs.calculateInverseProjectionMatrix()
                   * Vec3f(event.x, event.y, 1);
     Vec2f forward = normalize(world - transform.translation);
 
@@ -233,74 +263,70 @@ void PlayerControlScript::onMouseButtonReleased(const MouseButtonReleasedEvent&)
 void PlayerControlScript::onEnemyKilledEvent(const EnemyKilledEvent& event)
 {
     m_Entity.getComponent<ScoreComponent>().score += event.killScore;
-    printf("Player score: %llu\n", m_Entity.getComponent<ScoreComponent>().score);
+    printf("Player score: %llu\n", m_Entity.getComponent<const ScoreComponent>().score);
 }
 
 //==================================================================================================
 // CollisionHandlerScript
 //==================================================================================================
-const CollisionHandlerScript::onCollisionFunctionT CollisionHandlerScript::COLLISION_HANDLERS[GWARS_ENTITY_TYPES][GWARS_ENTITY_TYPES] = {
-    {                                      nullptr,                                           nullptr,     &CollisionHandlerScript::onCollisionPlayerUfo},
-    {                                      nullptr,                                           nullptr, &CollisionHandlerScript::onCollisionProjectileUfo},
-    {&CollisionHandlerScript::onCollisionPlayerUfo, &CollisionHandlerScript::onCollisionProjectileUfo,                                           nullptr}
-};
-
 CollisionHandlerScript::CollisionHandlerScript(Scene& scene, Entity player) : m_Scene(scene), m_Player(player) {}
 
+/* Only pairs of types having a handler are routed to the script */
+static const EventKey PLAYER_UFO_COLLISION_KEY =
+    CollisionEvent::makeLayersKey(getCollisionLayer(GWarsEntityComponent::EntityType::Player),
+                                  getCollisionLayer(GWarsEntityComponent::EntityType::Ufo));
+
+static const EventKey PROJECTILE_UFO_COLLISION_KEY =
+    CollisionEvent::makeLayersKey(getCollisionLayer(GWarsEntityComponent::EntityType::SpaceshipProjectile),
+                                  getCollisionLayer(GWarsEntityComponent::EntityType::Ufo));
+
 void CollisionHandlerScript::onAttach(Entity /*entity*/, EventDispatcher& eventDispatcher)
 {
-    eventDispatcher.getSink<CollisionEvent>().addHandler<&CollisionHandlerScript::onCollisionDetected>(*this);
+    EventSink<CollisionEvent>& sink = eventDispatcher.getSink<CollisionEvent>();
+    m_Connections.emplace_back(
+        sink.addKeyedHandler<&CollisionHandlerScript::onCollisionPlayerUfo>(PLAYER_UFO_COLLISION_KEY, *this));
+    m_Connections.emplace_back(
+        sink.addKeyedHandler<&CollisionHandlerScript::onCollisionProjectileUfo>(PROJECTILE_UFO_COLLISION_KEY, *this));
 }
 
-void CollisionHandlerScript::onDetach(Entity, EventDispatcher& eventDispatcher)
-{
-    eventDispatcher.getSink<CollisionEvent>().removeHandler<&CollisionHandlerScript::onCollisionDetected>(*this);
-}
+void CollisionHandlerScript::onDetach(Entity, EventDispatcher&) { m_Connections.clear(); }
 
 void CollisionHandlerScript::onUpdate(float) {}
 
-void CollisionHandlerScript::onCollisionDetected(CollisionEvent event)
-{
-    if (!event.firstEntity.hasComponent<GWarsEntityComponent>()
-        || !event.secondEntity.hasComponent<GWarsEntityComponent>())
-    {
-        return;
-    }
+uint32_t CollisionHandlerScript::getType() const { return static_cast<uint32_t>(ScriptType::CollisionHandler); }
 
-    GWarsEntityComponent::EntityType firstType  = event.firstEntity.getComponent<GWarsEntityComponent>().entityType;
-    GWarsEntityComponent::EntityType secondType = event.secondEntity.getComponent<GWarsEntityComponent>().entityType;
+void CollisionHandlerScript::save(BinaryWriter& writer) const { writer.writeValue(m_Player.getId()); }
+bool CollisionHandlerScript::load(BinaryReader& reader, Scene& scene) { return loadPlayer(reader, scene, m_Player); }
 
-    if (firstType > secondType)
+/* Player's layer is less than UFO's, so the player is the first entity */
+void CollisionHandlerScript::onCollisionPlayerUfo(const CollisionEvent& event)
+{
+    /* Collisions queued in the same frame as the game over one */
+    if (m_Scene.isStopped())
     {
-        Entity tmpEntity   = event.firstEntity;
-        event.firstEntity  = event.secondEntity;
-        event.secondEntity = tmpEntity;
-
-        GWarsEntityComponent::EntityType tmpType = firstType;
-        firstType                                = secondType;
-        secondType                               = tmpType;
+        return;
     }
 
-    onCollisionFunctionT handler = COLLISION_HANDLERS[static_cast<size_t>(firstType)][static_cast<size_t>(secondType)];
+    Entity player = m_Scene.getEntity(event.firstEntity);
 
-    if (handler != nullptr)
-    {
-        (this->*handler)(event.firstEntity, event.secondEntity);
-    }
-}
-
-void CollisionHandlerScript::onCollisionPlayerUfo(Entity player, Entity /* ufo */)
-{
     printf("GAME OVER!\n");
-    printf("Score: %llu\n", player.getComponent<ScoreComponent>().score);
+    printf("Score: %llu\n", player.getComponent<const ScoreComponent>().score);
     m_Scene.setStropped(true);
 }
 
-void CollisionHandlerScript::onCollisionProjectileUfo(Entity projectile, Entity ufo)
+void CollisionHandlerScript::onCollisionProjectileUfo(const CollisionEvent& event)
 {
+    if (m_Scene.isStopped())
+    {
+        return;
+    }
+
+    Entity projectile = m_Scene.getEntity(event.firstEntity);
+    Entity ufo        = m_Scene.getEntity(event.secondEntity);
+
     if (!m_Scene.isSubmittedToRemove(projectile) && !m_Scene.isSubmittedToRemove(ufo))
     {
-        Level level = ufo.getComponent<EnemyLevelComponent>().level;
+        Level level = ufo.getComponent<const EnemyLevelComponent>().level;
         m_Scene.getEventDispatcher().getSink<EnemyKilledEvent>().fireEvent(EnemyKilledEvent(ufo, UFO_SCORE * level));
         m_Scene.submitToRemoveEntity(projectile);
         m_Scene.submitToRemoveEntity(ufo);
@@ -310,18 +336,28 @@ void CollisionHandlerScript::onCollisionProjectileUfo(Entity projectile, Entity
 //==================================================================================================
 // EnemySpawnerScript
 //==================================================================================================
-EnemySpawnerScript::EnemySpawnerScript(Scene& scene, Entity player) : m_Scene(scene), m_Player(player) {}
-
-void EnemySpawnerScript::onAttach(Entity, EventDispatcher& eventDispatcher)
+EnemySpawnerScript::EnemySpawnerScript(Scene& scene, Entity player) : m_Scene(scene), m_Player(player)
 {
-    eventDispatcher.getSink<EnemyKilledEvent>().addHandler<&EnemySpawnerScript::onEnemyKilledEvent>(*this);
+    m_UfoPrefab.add<TransformComponent>(Vec2f(0, 0), 0.0f, UFO_SCALE)
+        .add<WorldTransformComponent>()
+        .add<GWarsEntityComponent>(GWarsEntityComponent::EntityType::Ufo)
+        .add<PolygonComponent>(UFO_MODEL)
+        .add<PhysicsComponent>()
+        .add<ParticleSystemComponent>(2048, FIRE_PARTICLE_MODEL)
+        .add<EnemyLevelComponent>()
+        .add<BoundingSphereComponent>(UFO_BOUNDING_SPHERE_RADIUS,
+                                      UFO_BOUNDING_SPHERE_TRANSLATION,
+                                      getCollisionLayer(GWarsEntityComponent::EntityType::Ufo));
 }
 
-void EnemySpawnerScript::onDetach(Entity, EventDispatcher& eventDispatcher)
+void EnemySpawnerScript::onAttach(Entity, EventDispatcher& eventDispatcher)
 {
-    eventDispatcher.getSink<EnemyKilledEvent>().removeHandler<&EnemySpawnerScript::onEnemyKilledEvent>(*this);
+    m_Connections.emplace_back(
+        eventDispatcher.getSink<EnemyKilledEvent>().addHandler<&EnemySpawnerScript::onEnemyKilledEvent>(*this));
 }
 
+void EnemySpawnerScript::onDetach(Entity, EventDispatcher&) { m_Connections.clear(); }
+
 void EnemySpawnerScript::onUpdate(float)
 {
     if (m_EnemiesLeft == 0)
@@ -331,6 +367,28 @@ void EnemySpawnerScript::onUpdate(float)
     }
 }
 
+uint32_t EnemySpawnerScript::getType() const { return static_cast<uint32_t>(ScriptType::EnemySpawner); }
+
+void EnemySpawnerScript::save(BinaryWriter& writer) const
+{
+    writer.writeValue(m_Player.getId());
+    writer.writeValue(m_EnemiesLeft);
+    writer.writeValue(m_EnemyLevel);
+}
+
+bool EnemySpawnerScript::load(BinaryReader& reader, Scene& scene)
+{
+    if (!loadPlayer(reader, scene, m_Player))
+    {
+        return false;
+    }
+
+    m_EnemiesLeft = reader.readValue<int32_t>();
+    m_EnemyLevel  = reader.readValue<Level>();
+
+    return m_EnemiesLeft >= 0 && m_EnemyLevel >= 1;
+}
+
 void EnemySpawnerScript::onEnemyKilledEvent(const EnemyKilledEvent&)
 {
     --m_EnemiesLeft;
@@ -338,12 +396,12 @@ void EnemySpawnerScript::onEnemyKilledEvent(const EnemyKilledEvent&)
 
 void EnemySpawnerScript::spawn()
 {
-    BoundingSphereComponent safeSpawnSphere = m_Player.getComponent<BoundingSphereComponent>();
+    BoundingSphereComponent safeSpawnSphere = m_Player.getComponent<const BoundingSphereComponent>();
     safeSpawnSphere.wsRadius += SAFE_SPAWN_RADIUS;
 
     int32_t toSpawn = RandomNumberGenerator::randomInRange(2, 7);
-    for (int32_t i = 0; i < toSpawn; ++i)
-    {
+
+    auto initializer = [safeSpawnSphere, level = m_EnemyLevel, player = m_Player](Entity ufo, size_t) {
         BoundingSphereComponent ufoSphere;
         Vec2f                   translation;
         do
@@ -355,19 +413,13 @@ void EnemySpawnerScript::spawn()
             ufoSphere.wsRadius      = UFO_BOUNDING_SPHERE_RADIUS * std::max(UFO_SCALE.x, UFO_SCALE.y);
         } while (boundingSpheresCollide(ufoSphere, safeSpawnSphere));
 
-        Entity ufo = m_Scene.createEntity();
-        ufo.createComponent<TransformComponent>(translation);
-        ufo.getComponent<TransformComponent>().scale = UFO_SCALE;
-        ufo.createComponent<GWarsEntityComponent>(GWarsEntityComponent::EntityType::Ufo);
-        ufo.createComponent<PolygonComponent>(UFO_MODEL);
-        ufo.createComponent<PhysicsComponent>();
-        ufo.createComponent<ParticleSystemComponent>(2048, loadPolygon("assets/fire_particle.txt"));
-        ufo.createComponent<EnemyLevelComponent>(m_EnemyLevel);
-        ufo.createComponent<BoundingSphereComponent>(UFO_BOUNDING_SPHERE_RADIUS, UFO_BOUNDING_SPHERE_TRANSLATION);
-        ufo.createComponent<ScriptComponent>(new EnemyMovementScript(m_Player));
-
-        ++m_EnemiesLeft;
-    }
+        ufo.getComponent<TransformComponent>().translation = translation;
+        ufo.getComponent<EnemyLevelComponent>().level      = level;
+        ufo.createComponent<ScriptComponent>(new EnemyMovementScript(player));
+    };
+
+    m_Scene.getCommandBuffer().instantiate(m_UfoPrefab, toSpawn, initializer);
+    m_EnemiesLeft += toSpawn;
 }
 
 //==================================================================================================
@@ -391,13 +443,13 @@ void EnemyMovementScript::onDetach(Entity /*entity*/, EventDispatcher& /*eventDi
 
 void EnemyMovementScript::onUpdate(float /*dt*/)
 {
-    assert(m_Entity.hasComponent<TransformComponent>());
+    assert(m_Entity.hasComponent<WorldTransformComponent>());
 
-    const TransformComponent& transformComponent = m_Entity.getComponent<TransformComponent>();
-    PhysicsComponent&         physicsComponent   = m_Entity.getComponent<PhysicsComponent>();
-    Vec2f                     forward            = calculateForward();
+    const WorldTransformComponent& worldTransform   = m_Entity.getComponent<const WorldTransformComponent>();
+    PhysicsComponent&              physicsComponent = m_Entity.getComponent<PhysicsComponent>();
+    Vec2f                          forward          = calculateForward();
 
-    Level level               = m_Entity.getComponent<EnemyLevelComponent>().level;
+    Level level               = m_Entity.getComponent<const EnemyLevelComponent>().level;
     physicsComponent.velocity = forward
                                 * std::max((UFO_VELOCITY_BASE + (level - 1) * UFO_VELOCITY_INCREMENT),
                                            UFO_VELOCITY_MAX);
@@ -405,17 +457,21 @@ void EnemyMovementScript::onUpdate(float /*dt*/)
     m_ParticleSpecs.velocity          = Vec2f(0, -150);
     m_ParticleSpecs.velocityVariation = Vec2f(150, 50);
 
-    Mat3f transformMatrix = transformComponent.calculateMatrix();
-    emit(transformMatrix * Vec3f(UFO_REACTOR_POSITION0, 1));
-    emit(transformMatrix * Vec3f(UFO_REACTOR_POSITION1, 1));
-    emit(transformMatrix * Vec3f(UFO_REACTOR_POSITION2, 1));
-    emit(transformMatrix * Vec3f(UFO_REACTOR_POSITION3, 1));
+    emit(worldTransform.matrix * Vec3f(UFO_REACTOR_POSITION0, 1));
+    emit(worldTransform.matrix * Vec3f(UFO_REACTOR_POSITION1, 1));
+    emit(worldTransform.matrix * Vec3f(UFO_REACTOR_POSITION2, 1));
+    emit(worldTransform.matrix * Vec3f(UFO_REACTOR_POSITION3, 1));
 }
 
+uint32_t EnemyMovementScript::getType() const { return static_cast<uint32_t>(ScriptType::EnemyMovement); }
+
+void EnemyMovementScript::save(BinaryWriter& writer) const { writer.writeValue(m_Player.getId()); }
+bool EnemyMovementScript::load(BinaryReader& reader, Scene& scene) { return loadPlayer(reader, scene, m_Player); }
+
 Vec2f EnemyMovementScript::calculateForward()
 {
-    return normalize(m_Player.getComponent<TransformComponent>().translation
-                     - m_Entity.getComponent<TransformComponent>().translation);
+    return normalize(m_Player.getComponent<const TransformComponent>().translation
+                     - m_Entity.getComponent<const TransformComponent>().translation);
 }
 
 void EnemyMovementScript::emit(Vec2f position)
@@ -434,7 +490,8 @@ void EnemyMovementScript::emit(Vec2f position)
 void ExplosionScript::onAttach(Entity entity, EventDispatcher& eventDispatcher)
 {
     m_Entity = entity;
-    eventDispatcher.getSink<EnemyKilledEvent>().addHandler<&ExplosionScript::onEnemyKilledEvent>(*this);
+    m_Connections.emplace_back(
+        eventDispatcher.getSink<EnemyKilledEvent>().addHandler<&ExplosionScript::onEnemyKilledEvent>(*this));
 
     m_ParticleSpecs.colorBegin = Vec4f(0.9f, 0.8f, 0.1f, 1.0f);
     m_ParticleSpecs.colorEnd   = Vec4f(1.0f, 0.4f, 0.1f, 0.0f);
@@ -448,18 +505,17 @@ void ExplosionScript::onAttach(Entity entity, EventDispatcher& eventDispatcher)
     m_ParticleSpecs.lifetime = 0.4f;
 }
 
-void ExplosionScript::onDetach(Entity /*entity*/, EventDispatcher& eventDispatcher)
-{
-    eventDispatcher.getSink<EnemyKilledEvent>().removeHandler<&ExplosionScript::onEnemyKilledEvent>(*this);
-}
+void ExplosionScript::onDetach(Entity /*entity*/, EventDispatcher& /*eventDispatcher*/) { m_Connections.clear(); }
 
 void ExplosionScript::onUpdate(float /*dt*/) {}
 
+uint32_t ExplosionScript::getType() const { return static_cast<uint32_t>(ScriptType::Explosion); }
+
 void ExplosionScript::onEnemyKilledEvent(EnemyKilledEvent event)
 {
     assert(m_Entity.hasComponent<ParticleSystemComponent>());
 
-    const TransformComponent& transform = event.enemy.getComponent<TransformComponent>();
+    const TransformComponent& transform = event.enemy.getComponent<const TransformComponent>();
 
     Vec2f translationRange(5, 5);
     for (uint32_t i = 0; i < 512; ++i)
@@ -474,4 +530,20 @@ void ExplosionScript::onEnemyKilledEvent(EnemyKilledEvent event)
     }
 }
 
+//==================================================================================================
+// Scripts factory
+//==================================================================================================
+INativeScript* createScript(ScriptType type, Scene& scene)
+{
+    switch (type)
+    {
+        case ScriptType::PlayerControl:    { return new PlayerControlScript(scene); }
+        case ScriptType::CollisionHandler: { return new CollisionHandlerScript(scene, Entity()); }
+        case ScriptType::EnemySpawner:     { return new EnemySpawnerScript(scene, Entity()); }
+        case ScriptType::EnemyMovement:    { return new EnemyMovementScript(Entity()); }
+        case ScriptType::Explosion:        { return new ExplosionScript(); }
+        default:                           { return nullptr; }
+    }
+}
+
 } // namespace gwars
\ No newline at end of file
@@ -26,33 +26,66 @@
  */
 
 #include "game_layer.hpp"
-#include "assets_management/polygon_loader.hpp"
 #include "game_data.hpp"
+#include "ecs/snapshot.hpp"
 #include "input/keyboard.hpp"
 #include "input/mouse.hpp"
+#include "utils/mapped_file.hpp"
+#include <stdio.h>
 
 namespace gwars {
 
-GameLayer::GameLayer(EventDispatcher& eventDispatcher) : m_GameScene(eventDispatcher) {}
+static const uint32_t SNAPSHOT_MAGIC   = 0x53574747; // "GGWS"
+static const uint32_t SNAPSHOT_VERSION = 3;
+static const char*    SNAPSHOT_FILENAME = "gwars.snapshot";
 
-bool GameLayer::isStopped() const { return m_Stopped; }
-void GameLayer::setStopped(bool stopped) { m_Stopped = stopped; }
+GameLayer::GameLayer(EventDispatcher& eventDispatcher)
+    : m_GameScene(eventDispatcher),
+      m_KeyPressedConnection(eventDispatcher.getSink<KeyPressedEvent>().addHandler<&GameLayer::onKeyPressed>(*this))
+{
+}
+
+GameLayer::~GameLayer() { m_GameScene.getEventDispatcher().printProfile(); }
 
 void GameLayer::onInit()
 {
     m_GameScene.onInit();
 
+    /* Preallocate storage for projectiles and enemies, so that spawning them doesn't allocate */
+    EntityManager& entityManager = m_GameScene.getEntityManager();
+    entityManager.reserveEntities(ENTITIES_RESERVED);
+    entityManager.reserve<TransformComponent>(ENTITIES_RESERVED);
+    entityManager.reserve<WorldTransformComponent>(ENTITIES_RESERVED);
+    entityManager.reserve<GWarsEntityComponent>(ENTITIES_RESERVED);
+    entityManager.reserve<PolygonComponent>(ENTITIES_RESERVED);
+    entityManager.reserve<PhysicsComponent>(ENTITIES_RESERVED);
+    entityManager.reserve<BoundingSphereComponent>(ENTITIES_RESERVED);
+
+    createWorld();
+}
+
+void GameLayer::restart()
+{
+    m_GameScene.clear();
+    createWorld();
+    m_GameScene.setStropped(false);
+}
+
+void GameLayer::createWorld()
+{
     Entity player = m_GameScene.createEntity();
     player.createComponent<TransformComponent>(Vec2f(50, 50));
     player.getComponent<TransformComponent>().scale = SPACESHIP_SCALE;
+    player.createComponent<WorldTransformComponent>();
     player.createComponent<GWarsEntityComponent>(GWarsEntityComponent::EntityType::Player);
     player.createComponent<ScoreComponent>();
     player.createComponent<PolygonComponent>(SPACESHIP_MODEL);
-    player.createComponent<ParticleSystemComponent>(2048, loadPolygon("assets/fire_particle.txt"));
+    player.createComponent<ParticleSystemComponent>(2048, FIRE_PARTICLE_MODEL);
     player.createComponent<ScriptComponent>(new PlayerControlScript(m_GameScene));
     player.createComponent<PhysicsComponent>();
     player.createComponent<BoundingSphereComponent>(SPACESHIP_BOUNDING_SPHERE_RADIUS,
-                                                    SPACESHIP_BOUNDING_SPHERE_TRANSLATION);
+                                                    SPACESHIP_BOUNDING_SPHERE_TRANSLATION,
+                                                    getCollisionLayer(GWarsEntityComponent::EntityType::Player));
 
     Entity collisionHandler = m_GameScene.createEntity();
     collisionHandler.createComponent<ScriptComponent>(new CollisionHandlerScript(m_GameScene, player));
@@ -62,21 +95,188 @@ void GameLayer::onInit()
 
     Entity explosionHandler = m_GameScene.createEntity();
     explosionHandler.createComponent<ScriptComponent>(new ExplosionScript());
-    explosionHandler.createComponent<ParticleSystemComponent>(512, loadPolygon("assets/fire_particle.txt"));
+    explosionHandler.createComponent<ParticleSystemComponent>(512, FIRE_PARTICLE_MODEL);
 
     Entity camera = m_GameScene.createEntity();
     camera.createComponent<TransformComponent>();
+    camera.createComponent<WorldTransformComponent>();
     camera.createComponent<CameraComponent>(OrthographicCameraSpecs(1024, 768), true);
 }
 
+bool GameLayer::saveSnapshot(const char* filename)
+{
+    EntityManager& entityManager = m_GameScene.getEntityManager();
+
+    BinaryWriter writer;
+    writer.writeValue(SNAPSHOT_MAGIC);
+    writer.writeValue(SNAPSHOT_VERSION);
+
+    entityManager.saveEntities(writer);
+
+    savePool<TransformComponent>(entityManager, writer);
+    savePool<WorldTransformComponent>(entityManager, writer);
+    savePool<HierarchyComponent>(entityManager, writer);
+    savePool<GWarsEntityComponent>(entityManager, writer);
+    savePool<PhysicsComponent>(entityManager, writer);
+    savePool<BoundingSphereComponent>(entityManager, writer);
+    savePool<ScoreComponent>(entityManager, writer);
+    savePool<EnemyLevelComponent>(entityManager, writer);
+
+    /* Cameras go through construct events, so that the scene picks up its main camera on load */
+    savePool<CameraComponent>(entityManager, writer, [](BinaryWriter& writer, const CameraComponent& camera) {
+        writer.writeValue(camera);
+    });
+
+    savePool<PolygonComponent>(entityManager, writer, [](BinaryWriter& writer, const PolygonComponent& polygon) {
+        writePolygon(writer, polygon.polygon);
+    });
+
+    savePool<ParticleSystemComponent>(entityManager, writer,
+                                      [](BinaryWriter& writer, const ParticleSystemComponent& particleSystem) {
+                                          particleSystem.particleSystem.save(writer);
+                                      });
+
+    /* Scripts are loaded last, as they are attached to already complete entities */
+    savePool<ScriptComponent>(entityManager, writer, [](BinaryWriter& writer, const ScriptComponent& script) {
+        writer.writeValue(script.nativeScript->getType());
+        script.nativeScript->save(writer);
+    });
+
+    if (!writer.saveToFile(filename))
+    {
+        printf("Couldn't save snapshot to '%s'\n", filename);
+        return false;
+    }
+
+    return true;
+}
+
+bool GameLayer::loadSnapshot(const char* filename)
+{
+    MappedFile file;
+    if (!file.open(filename))
+    {
+        printf("Couldn't open snapshot '%s'\n", filename);
+        return false;
+    }
+
+    BinaryReader reader(file.getData(), file.getSize());
+    if (reader.readValue<uint32_t>() != SNAPSHOT_MAGIC || reader.readValue<uint32_t>() != SNAPSHOT_VERSION)
+    {
+        printf("'%s' is not a snapshot of a supported version\n", filename);
+        return false;
+    }
+
+    m_GameScene.clear();
+
+    if (!loadWorld(reader))
+    {
+        printf("Snapshot '%s' is corrupted, starting a new round\n", filename);
+        restart();
+        return false;
+    }
+
+    m_GameScene.setStropped(false);
+    return true;
+}
+
+bool GameLayer::loadWorld(BinaryReader& reader)
+{
+    EntityManager& entityManager = m_GameScene.getEntityManager();
+    Scene&         scene         = m_GameScene;
+
+    auto loadCamera = [](BinaryReader& reader, CameraComponent& camera) {
+        camera = reader.readValue<CameraComponent>();
+        return true;
+    };
+
+    auto loadPolygon = [](BinaryReader& reader, PolygonComponent& polygon) {
+        polygon.polygon = readPolygon(reader);
+        return true;
+    };
+
+    auto loadParticleSystem = [](BinaryReader& reader, ParticleSystemComponent& particleSystem) {
+        return particleSystem.particleSystem.load(reader);
+    };
+
+    auto loadScript = [&scene](BinaryReader& reader, ScriptComponent& script) {
+        script.nativeScript = createScript(static_cast<ScriptType>(reader.readValue<uint32_t>()), scene);
+        if (script.nativeScript == nullptr)
+        {
+            return false;
+        }
+
+        return script.nativeScript->load(reader, scene);
+    };
+
+    /* Links of a corrupted hierarchy are dropped, so that clearing the scene doesn't follow them */
+    auto loadHierarchy = [&entityManager](BinaryReader& reader) {
+        if (!loadPool<HierarchyComponent>(entityManager, reader))
+        {
+            return false;
+        }
+
+        if (isValidHierarchy(entityManager))
+        {
+            return true;
+        }
+
+        ComponentPool<HierarchyComponent>& hierarchies = entityManager.getPool<HierarchyComponent>();
+        for (size_t i = 0; i < hierarchies.size(); ++i)
+        {
+            hierarchies.getComponent(i) = HierarchyComponent{};
+        }
+
+        return false;
+    };
+
+    return entityManager.loadEntities(reader)
+           && loadPool<TransformComponent>(entityManager, reader)
+           && loadPool<WorldTransformComponent>(entityManager, reader)
+           && loadHierarchy(reader)
+           && loadPool<GWarsEntityComponent>(entityManager, reader)
+           && loadPool<PhysicsComponent>(entityManager, reader)
+           && loadPool<BoundingSphereComponent>(entityManager, reader)
+           && loadPool<ScoreComponent>(entityManager, reader)
+           && loadPool<EnemyLevelComponent>(entityManager, reader)
+           && loadPool<CameraComponent>(entityManager, reader, loadCamera)
+           && loadPool<PolygonComponent>(entityManager, reader, loadPolygon)
+           && loadPool<ParticleSystemComponent>(entityManager, reader, loadParticleSystem)
+           && loadPool<ScriptComponent>(entityManager, reader, loadScript);
+}
+
 void GameLayer::onUpdate(float dt)
 {
+    /* Game over, starting a new round */
     if (m_GameScene.isStopped())
     {
-        setStopped(true);
+        restart();
     }
 
     m_GameScene.onUpdate(dt);
+
+    m_StatsTimer += dt;
+    if (m_StatsTimer >= STATS_PRINT_PERIOD)
+    {
+        m_StatsTimer = 0;
+        printStats();
+    }
+}
+
+void GameLayer::printStats()
+{
+    m_GameScene.getEntityManager().printStats();
+    m_GameScene.getEventDispatcher().printProfile();
+}
+
+void GameLayer::onKeyPressed(const KeyPressedEvent& event)
+{
+    switch (event.key)
+    {
+        case Key::Space:  { saveSnapshot(SNAPSHOT_FILENAME); break; }
+        case Key::Return: { loadSnapshot(SNAPSHOT_FILENAME); break; }
+        default:          { break; }
+    }
 }
 
 void GameLayer::onRender(Renderer& renderer) { m_GameScene.render(renderer); }
@@ -26,6 +26,7 @@
  */
 
 #include "renderer/draw_primitives.hpp"
+#include <string.h>
 
 namespace gwars {
 
@@ -68,4 +69,31 @@ Polygon Polygon::createQuad(Vec2f v0, Vec2f v1, Vec2f v2, Vec2f v3, Color color,
     return polygon;
 }
 
+void writePolygon(BinaryWriter& writer, const Polygon& polygon)
+{
+    writer.writeValue(polygon.color);
+    writer.writeValue(polygon.thickness);
+    writer.writeValue<uint64_t>(polygon.vertices.size());
+    writer.write(polygon.vertices.data(), polygon.vertices.size() * sizeof(Polygon::Vertex));
+}
+
+Polygon readPolygon(BinaryReader& reader)
+{
+    Polygon polygon;
+    polygon.color     = reader.readValue<Color>();
+    polygon.thickness = reader.readValue<float>();
+
+    uint64_t               verticesCount = reader.readValue<uint64_t>();
+    const Polygon::Vertex* vertices      = static_cast<const Polygon::Vertex*>(
+        reader.readArray(verticesCount, sizeof(Polygon::Vertex), 1));
+
+    if (vertices != nullptr && verticesCount > 0)
+    {
+        polygon.vertices.resize(verticesCount);
+        memcpy(polygon.vertices.data(), vertices, verticesCount * sizeof(Polygon::Vertex));
+    }
+
+    return polygon;
+}
+
 } // namespace gwars
\ No newline at end of file
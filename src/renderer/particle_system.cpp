@@ -102,4 +102,36 @@ void ParticleSystem::emit(const ParticleSpecs& particleSpecs)
     m_NextParticle = (m_NextParticle + 1) % m_Particles.size();
 }
 
+size_t ParticleSystem::getHeapBytes() const
+{
+    return m_Particles.capacity() * sizeof(Particle) + m_ParticlePolygon.getHeapBytes();
+}
+
+void ParticleSystem::save(BinaryWriter& writer) const
+{
+    writePolygon(writer, m_ParticlePolygon);
+
+    writer.writeValue(m_NextParticle);
+    writer.writeValue<uint64_t>(m_Particles.size());
+    writer.writeBlock(m_Particles.data(), m_Particles.size() * sizeof(Particle), alignof(Particle));
+}
+
+bool ParticleSystem::load(BinaryReader& reader)
+{
+    m_ParticlePolygon = readPolygon(reader);
+    m_NextParticle    = reader.readValue<uint32_t>();
+
+    uint64_t        particlesCount = reader.readValue<uint64_t>();
+    const Particle* particles      = static_cast<const Particle*>(
+        reader.readArray(particlesCount, sizeof(Particle), alignof(Particle)));
+
+    if (reader.isFailed() || m_NextParticle >= particlesCount)
+    {
+        return false;
+    }
+
+    m_Particles.assign(particles, particles + particlesCount);
+    return true;
+}
+
 } // namespace gwars
\ No newline at end of file
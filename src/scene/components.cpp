@@ -29,6 +29,139 @@
 
 namespace gwars {
 
+static void unlinkFromParent(EntityManager& manager, EntityId child, HierarchyComponent& childHierarchy)
+{
+    if (childHierarchy.parent == INVALID_ENTITY_ID)
+    {
+        return;
+    }
+
+    HierarchyComponent& parentHierarchy = manager.getComponent<HierarchyComponent>(childHierarchy.parent);
+    if (parentHierarchy.firstChild == child)
+    {
+        parentHierarchy.firstChild = childHierarchy.nextSibling;
+    }
+    else
+    {
+        EntityId sibling = parentHierarchy.firstChild;
+        while (manager.getComponent<const HierarchyComponent>(sibling).nextSibling != child)
+        {
+            sibling = manager.getComponent<const HierarchyComponent>(sibling).nextSibling;
+            assert(sibling != INVALID_ENTITY_ID);
+        }
+
+        manager.getComponent<HierarchyComponent>(sibling).nextSibling = childHierarchy.nextSibling;
+    }
+
+    childHierarchy.parent      = INVALID_ENTITY_ID;
+    childHierarchy.nextSibling = INVALID_ENTITY_ID;
+}
+
+void setParent(EntityManager& manager, EntityId child, EntityId parent)
+{
+    assert(child != parent);
+
+    if (!manager.hasComponent<HierarchyComponent>(child))
+    {
+        manager.createComponent<HierarchyComponent>(child);
+    }
+
+    if (parent != INVALID_ENTITY_ID && !manager.hasComponent<HierarchyComponent>(parent))
+    {
+        manager.createComponent<HierarchyComponent>(parent);
+    }
+
+    /* The parent must not be a descendant of the child */
+    for (EntityId ancestor = parent; ancestor != INVALID_ENTITY_ID;
+         ancestor          = manager.getComponent<const HierarchyComponent>(ancestor).parent)
+    {
+        assert(ancestor != child);
+    }
+
+    HierarchyComponent& childHierarchy = manager.getComponent<HierarchyComponent>(child);
+    unlinkFromParent(manager, child, childHierarchy);
+
+    if (parent != INVALID_ENTITY_ID)
+    {
+        HierarchyComponent& parentHierarchy = manager.getComponent<HierarchyComponent>(parent);
+
+        childHierarchy.parent      = parent;
+        childHierarchy.nextSibling = parentHierarchy.firstChild;
+        parentHierarchy.firstChild = child;
+    }
+}
+
+void unlinkFromHierarchy(EntityManager& manager, EntityId id)
+{
+    HierarchyComponent& hierarchy = manager.getComponent<HierarchyComponent>(id);
+    unlinkFromParent(manager, id, hierarchy);
+
+    EntityId child = hierarchy.firstChild;
+    while (child != INVALID_ENTITY_ID)
+    {
+        HierarchyComponent& childHierarchy = manager.getComponent<HierarchyComponent>(child);
+
+        child                      = childHierarchy.nextSibling;
+        childHierarchy.parent      = INVALID_ENTITY_ID;
+        childHierarchy.nextSibling = INVALID_ENTITY_ID;
+    }
+
+    hierarchy.firstChild = INVALID_ENTITY_ID;
+}
+
+bool isValidHierarchy(EntityManager& manager)
+{
+    const ComponentPool<HierarchyComponent>& hierarchies = manager.getPool<HierarchyComponent>();
+    const size_t                             count       = hierarchies.size();
+
+    auto isLink = [&hierarchies](EntityId id) { return id == INVALID_ENTITY_ID || hierarchies.contains(id); };
+
+    size_t parentedCount = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const HierarchyComponent& hierarchy = hierarchies.getComponents()[i];
+        if (!isLink(hierarchy.parent) || !isLink(hierarchy.firstChild) || !isLink(hierarchy.nextSibling))
+        {
+            return false;
+        }
+
+        parentedCount += hierarchy.parent != INVALID_ENTITY_ID;
+    }
+
+    /* Chains longer than the pool are cycles. Children pointing back at their parent, which together list
+     * every parented entity, are listed exactly once. */
+    size_t listedCount = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const EntityId            id        = hierarchies.getEntity(i);
+        const HierarchyComponent& hierarchy = hierarchies.getComponents()[i];
+
+        size_t childrenCount = 0;
+        for (EntityId child = hierarchy.firstChild; child != INVALID_ENTITY_ID;
+             child          = hierarchies.get(child).nextSibling)
+        {
+            if (hierarchies.get(child).parent != id || ++childrenCount > count)
+            {
+                return false;
+            }
+        }
+
+        size_t depth = 0;
+        for (EntityId ancestor = hierarchy.parent; ancestor != INVALID_ENTITY_ID;
+             ancestor          = hierarchies.get(ancestor).parent)
+        {
+            if (++depth > count)
+            {
+                return false;
+            }
+        }
+
+        listedCount += childrenCount;
+    }
+
+    return listedCount == parentedCount;
+}
+
 bool boundingSpheresCollide(const BoundingSphereComponent& first, const BoundingSphereComponent& second)
 {
     return lengthSquare(second.wsTranslation - first.wsTranslation)
@@ -0,0 +1,323 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file rigid_body_storage.cpp
+ * @date 2026-10-17
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "scene/rigid_body_storage.hpp"
+#include <algorithm>
+#include <cassert>
+#include <new>
+#include <string.h>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+using namespace gwars;
+
+static_assert(RigidBodyStorage::BLOCK_SIZE % 8 == 0, "Blocks must hold a whole number of AVX registers");
+static_assert(RigidBodyStorage::COLUMN_ALIGNMENT % 32 == 0, "Columns must be aligned for AVX loads");
+
+//==================================================================================================
+// Kernels
+//==================================================================================================
+struct BodyColumns
+{
+    float* __restrict__       translationX;
+    float* __restrict__       translationY;
+    float* __restrict__       velocityX;
+    float* __restrict__       velocityY;
+    const float* __restrict__ forceX;
+    const float* __restrict__ forceY;
+    const float* __restrict__ mass;
+};
+
+static void integrateScalarKernel(const BodyColumns& columns, size_t count, float dt)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        columns.velocityX[i] += columns.forceX[i] / columns.mass[i] * dt;
+        columns.velocityY[i] += columns.forceY[i] / columns.mass[i] * dt;
+
+        columns.translationX[i] += columns.velocityX[i] * dt;
+        columns.translationY[i] += columns.velocityY[i] * dt;
+    }
+}
+
+/* Count is a multiple of the block size and columns are aligned, so whole registers are loaded and stored */
+static void integrateSimdKernel(const BodyColumns& columns, size_t count, float dt)
+{
+#if defined(__AVX__)
+    const __m256 step = _mm256_set1_ps(dt);
+    for (size_t i = 0; i < count; i += 8)
+    {
+        __m256 mass          = _mm256_load_ps(columns.mass + i);
+        __m256 accelerationX = _mm256_div_ps(_mm256_load_ps(columns.forceX + i), mass);
+        __m256 accelerationY = _mm256_div_ps(_mm256_load_ps(columns.forceY + i), mass);
+
+        __m256 velocityX = _mm256_add_ps(_mm256_load_ps(columns.velocityX + i), _mm256_mul_ps(accelerationX, step));
+        __m256 velocityY = _mm256_add_ps(_mm256_load_ps(columns.velocityY + i), _mm256_mul_ps(accelerationY, step));
+
+        _mm256_store_ps(columns.velocityX + i, velocityX);
+        _mm256_store_ps(columns.velocityY + i, velocityY);
+
+        _mm256_store_ps(columns.translationX + i,
+                        _mm256_add_ps(_mm256_load_ps(columns.translationX + i), _mm256_mul_ps(velocityX, step)));
+        _mm256_store_ps(columns.translationY + i,
+                        _mm256_add_ps(_mm256_load_ps(columns.translationY + i), _mm256_mul_ps(velocityY, step)));
+    }
+#elif defined(__SSE2__)
+    const __m128 step = _mm_set1_ps(dt);
+    for (size_t i = 0; i < count; i += 4)
+    {
+        __m128 mass          = _mm_load_ps(columns.mass + i);
+        __m128 accelerationX = _mm_div_ps(_mm_load_ps(columns.forceX + i), mass);
+        __m128 accelerationY = _mm_div_ps(_mm_load_ps(columns.forceY + i), mass);
+
+        __m128 velocityX = _mm_add_ps(_mm_load_ps(columns.velocityX + i), _mm_mul_ps(accelerationX, step));
+        __m128 velocityY = _mm_add_ps(_mm_load_ps(columns.velocityY + i), _mm_mul_ps(accelerationY, step));
+
+        _mm_store_ps(columns.velocityX + i, velocityX);
+        _mm_store_ps(columns.velocityY + i, velocityY);
+
+        _mm_store_ps(columns.translationX + i,
+                     _mm_add_ps(_mm_load_ps(columns.translationX + i), _mm_mul_ps(velocityX, step)));
+        _mm_store_ps(columns.translationY + i,
+                     _mm_add_ps(_mm_load_ps(columns.translationY + i), _mm_mul_ps(velocityY, step)));
+    }
+#else
+    integrateScalarKernel(columns, count, dt);
+#endif
+}
+
+//==================================================================================================
+// RigidBodyStorage
+//==================================================================================================
+RigidBodyStorage::~RigidBodyStorage()
+{
+    if (m_Columns != nullptr)
+    {
+        ::operator delete(m_Columns, std::align_val_t(COLUMN_ALIGNMENT));
+    }
+}
+
+void RigidBodyStorage::addBody(EntityId id, const Vec2f& translation, const Vec2f& velocity, float mass)
+{
+    assert(id != INVALID_ENTITY_ID);
+    assert(!contains(id));
+    assert(mass > 0);
+
+    size_t position = m_Entities.size();
+    if (position == m_Capacity)
+    {
+        reserve(std::max(2 * m_Capacity, BLOCK_SIZE));
+    }
+
+    uint32_t index = getEntityIndex(id);
+    if (index >= m_Positions.size())
+    {
+        m_Positions.resize(index + 1, INVALID_POSITION);
+    }
+
+    m_Positions[index] = static_cast<uint32_t>(position);
+    m_Entities.push_back(id);
+
+    getColumn(COLUMN_TRANSLATION_X)[position] = translation.x;
+    getColumn(COLUMN_TRANSLATION_Y)[position] = translation.y;
+    getColumn(COLUMN_VELOCITY_X)[position]    = velocity.x;
+    getColumn(COLUMN_VELOCITY_Y)[position]    = velocity.y;
+    getColumn(COLUMN_MASS)[position]          = mass;
+}
+
+void RigidBodyStorage::removeBody(EntityId id)
+{
+    size_t position = getPosition(id);
+    size_t last     = m_Entities.size() - 1;
+
+    /* Swap-and-pop, the vacated slot becomes padding */
+    for (size_t column = 0; column < COLUMNS_COUNT; ++column)
+    {
+        float* values    = getColumn(static_cast<Column>(column));
+        values[position] = values[last];
+    }
+
+    EntityId moved = m_Entities[last];
+
+    m_Entities[position]               = moved;
+    m_Positions[getEntityIndex(moved)] = static_cast<uint32_t>(position);
+    m_Positions[getEntityIndex(id)]    = INVALID_POSITION;
+    m_Entities.pop_back();
+
+    resetBodies(last, last + 1);
+}
+
+bool RigidBodyStorage::contains(EntityId id) const
+{
+    uint32_t index = getEntityIndex(id);
+    return index < m_Positions.size() && m_Positions[index] != INVALID_POSITION
+           && m_Entities[m_Positions[index]] == id;
+}
+
+void RigidBodyStorage::clear()
+{
+    for (EntityId id : m_Entities)
+    {
+        m_Positions[getEntityIndex(id)] = INVALID_POSITION;
+    }
+
+    resetBodies(0, m_Entities.size());
+    m_Entities.clear();
+}
+
+void RigidBodyStorage::reserve(size_t capacity)
+{
+    capacity = (capacity + BLOCK_SIZE - 1) / BLOCK_SIZE * BLOCK_SIZE;
+    if (capacity <= m_Capacity)
+    {
+        return;
+    }
+
+    float* columns = static_cast<float*>(
+        ::operator new(COLUMNS_COUNT * capacity * sizeof(float), std::align_val_t(COLUMN_ALIGNMENT)));
+
+    if (m_Columns != nullptr)
+    {
+        for (size_t column = 0; column < COLUMNS_COUNT; ++column)
+        {
+            memcpy(columns + column * capacity, m_Columns + column * m_Capacity, m_Capacity * sizeof(float));
+        }
+
+        ::operator delete(m_Columns, std::align_val_t(COLUMN_ALIGNMENT));
+    }
+
+    size_t oldCapacity = m_Capacity;
+    m_Columns          = columns;
+    m_Capacity         = capacity;
+
+    m_Entities.reserve(capacity);
+    resetBodies(oldCapacity, capacity);
+}
+
+Vec2f RigidBodyStorage::getTranslation(EntityId id) const
+{
+    size_t position = getPosition(id);
+    return Vec2f(getColumn(COLUMN_TRANSLATION_X)[position], getColumn(COLUMN_TRANSLATION_Y)[position]);
+}
+
+Vec2f RigidBodyStorage::getVelocity(EntityId id) const
+{
+    size_t position = getPosition(id);
+    return Vec2f(getColumn(COLUMN_VELOCITY_X)[position], getColumn(COLUMN_VELOCITY_Y)[position]);
+}
+
+Vec2f RigidBodyStorage::getForce(EntityId id) const
+{
+    size_t position = getPosition(id);
+    return Vec2f(getColumn(COLUMN_FORCE_X)[position], getColumn(COLUMN_FORCE_Y)[position]);
+}
+
+float RigidBodyStorage::getMass(EntityId id) const { return getColumn(COLUMN_MASS)[getPosition(id)]; }
+
+void RigidBodyStorage::setTranslation(EntityId id, const Vec2f& translation)
+{
+    size_t position                           = getPosition(id);
+    getColumn(COLUMN_TRANSLATION_X)[position] = translation.x;
+    getColumn(COLUMN_TRANSLATION_Y)[position] = translation.y;
+}
+
+void RigidBodyStorage::setVelocity(EntityId id, const Vec2f& velocity)
+{
+    size_t position                        = getPosition(id);
+    getColumn(COLUMN_VELOCITY_X)[position] = velocity.x;
+    getColumn(COLUMN_VELOCITY_Y)[position] = velocity.y;
+}
+
+void RigidBodyStorage::setForce(EntityId id, const Vec2f& force)
+{
+    size_t position                     = getPosition(id);
+    getColumn(COLUMN_FORCE_X)[position] = force.x;
+    getColumn(COLUMN_FORCE_Y)[position] = force.y;
+}
+
+void RigidBodyStorage::setMass(EntityId id, float mass)
+{
+    assert(mass > 0);
+    getColumn(COLUMN_MASS)[getPosition(id)] = mass;
+}
+
+void RigidBodyStorage::integrate(float dt)
+{
+    BodyColumns columns{getColumn(COLUMN_TRANSLATION_X), getColumn(COLUMN_TRANSLATION_Y),
+                        getColumn(COLUMN_VELOCITY_X),    getColumn(COLUMN_VELOCITY_Y),
+                        getColumn(COLUMN_FORCE_X),       getColumn(COLUMN_FORCE_Y),
+                        getColumn(COLUMN_MASS)};
+
+    /* Padding bodies are at rest with unit mass, so integrating them is harmless */
+    integrateSimdKernel(columns, (m_Entities.size() + BLOCK_SIZE - 1) / BLOCK_SIZE * BLOCK_SIZE, dt);
+}
+
+void RigidBodyStorage::integrateScalar(float dt)
+{
+    BodyColumns columns{getColumn(COLUMN_TRANSLATION_X), getColumn(COLUMN_TRANSLATION_Y),
+                        getColumn(COLUMN_VELOCITY_X),    getColumn(COLUMN_VELOCITY_Y),
+                        getColumn(COLUMN_FORCE_X),       getColumn(COLUMN_FORCE_Y),
+                        getColumn(COLUMN_MASS)};
+
+    integrateScalarKernel(columns, m_Entities.size(), dt);
+}
+
+float* RigidBodyStorage::getColumn(Column column)
+{
+    assert(column < COLUMNS_COUNT);
+    return m_Columns + column * m_Capacity;
+}
+
+const float* RigidBodyStorage::getColumn(Column column) const
+{
+    assert(column < COLUMNS_COUNT);
+    return m_Columns + column * m_Capacity;
+}
+
+const EntityId* RigidBodyStorage::getEntities() const { return m_Entities.data(); }
+
+size_t RigidBodyStorage::size() const { return m_Entities.size(); }
+size_t RigidBodyStorage::capacity() const { return m_Capacity; }
+
+size_t RigidBodyStorage::getPosition(EntityId id) const
+{
+    assert(contains(id));
+    return m_Positions[getEntityIndex(id)];
+}
+
+void RigidBodyStorage::resetBodies(size_t begin, size_t end)
+{
+    for (size_t column = 0; column < COLUMNS_COUNT; ++column)
+    {
+        float* values = getColumn(static_cast<Column>(column));
+        std::fill(values + begin, values + end, (column == COLUMN_MASS) ? 1.0f : 0.0f);
+    }
+}
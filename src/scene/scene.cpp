@@ -27,22 +27,91 @@
 
 #include "scene/scene.hpp"
 #include "ecs/entity_view.hpp"
+#include "scene/systems.hpp"
+#include <algorithm>
 #include <stdio.h>
 
 using namespace gwars;
 
-CollisionEvent::CollisionEvent(Entity firstEntity, Entity secondEntity)
-    : firstEntity(firstEntity), secondEntity(secondEntity)
+CollisionEvent::CollisionEvent(EntityId firstEntity, EntityId secondEntity, uint16_t firstLayer, uint16_t secondLayer)
+    : firstEntity(firstEntity), secondEntity(secondEntity), firstLayer(firstLayer), secondLayer(secondLayer)
 {
 }
 
-Scene::Scene(EventDispatcher& eventDispatcher) : m_EventDispatcher(eventDispatcher) {}
+size_t CollisionEvent::getRoutingKeys(EventKey* keys) const
+{
+    keys[0] = makeEntityKey(firstEntity);
+    keys[1] = makeEntityKey(secondEntity);
+    keys[2] = makeLayersKey(firstLayer, secondLayer);
+
+    return 3;
+}
+
+EventKey CollisionEvent::makeEntityKey(EntityId id) { return static_cast<EventKey>(id); }
+
+/* Entity keys only take the lower 32 bits */
+EventKey CollisionEvent::makeLayersKey(uint16_t firstLayer, uint16_t secondLayer)
+{
+    uint16_t minLayer = std::min(firstLayer, secondLayer);
+    uint16_t maxLayer = std::max(firstLayer, secondLayer);
+
+    return (EventKey{1} << 32) | (static_cast<EventKey>(minLayer) << 16) | static_cast<EventKey>(maxLayer);
+}
+
+Scene::Scene(EventDispatcher& eventDispatcher)
+    : m_EventDispatcher(eventDispatcher),
+      m_CommandBuffers(MAX_THREADS),
+      m_Scheduler(m_Entities),
+      m_Renderables(m_Entities)
+{
+    /* Particles, physics and bounding spheres touch disjoint data except for transforms, so particles
+     * are updated concurrently with physics, and bounding spheres wait for physics only */
+    m_Scheduler.addSystem(new ScriptSystem(*this));
+    m_Scheduler.addSystem(new ParticleSystemUpdateSystem(*this));
+    m_Scheduler.addSystem(new PhysicsSystem(*this));
+
+    /* Also run after the sync point, so that entities created there are rendered in place */
+    m_TransformSystem = new TransformSystem(*this);
+    m_Scheduler.addSystem(m_TransformSystem);
+    m_Scheduler.addSystem(new BoundingSphereSystem(*this));
+    m_Scheduler.addSystem(new CollisionSystem(*this));
+}
 
 Entity Scene::createEntity() { return Entity(m_Entities.createEntity(), m_Entities); }
+Entity Scene::getEntity(EntityId id) { return Entity(id, m_Entities); }
 
-void Scene::submitToRemoveEntity(Entity entity) { m_EntitiesToRemove.insert(entity); }
+void Scene::submitToRemoveEntity(Entity entity)
+{
+    uint32_t index = getEntityIndex(entity.getId());
+    if (index >= m_PendingDestroy.size())
+    {
+        m_PendingDestroy.resize(index + 1, false);
+    }
 
-bool Scene::isSubmittedToRemove(Entity entity) { return m_EntitiesToRemove.find(entity) != m_EntitiesToRemove.end(); }
+    if (!m_PendingDestroy[index])
+    {
+        m_PendingDestroy[index] = true;
+        getCommandBuffer().destroyEntity(entity.getId());
+    }
+}
+
+bool Scene::isSubmittedToRemove(Entity entity) const
+{
+    uint32_t index = getEntityIndex(entity.getId());
+    return index < m_PendingDestroy.size() && m_PendingDestroy[index];
+}
+
+CommandBuffer& Scene::getCommandBuffer() { return m_CommandBuffers[getThreadIndex()]; }
+
+void Scene::flushCommandBuffers()
+{
+    for (CommandBuffer& commandBuffer : m_CommandBuffers)
+    {
+        commandBuffer.flush(m_Entities);
+    }
+
+    m_PendingDestroy.assign(m_PendingDestroy.size(), false);
+}
 
 EntityManager&   Scene::getEntityManager() { return m_Entities; }
 EventDispatcher& Scene::getEventDispatcher() { return m_EventDispatcher; }
@@ -51,10 +120,21 @@ Entity           Scene::getMainCamera() { return m_MainCamera; }
 bool Scene::isStopped() const { return m_Stopped; }
 void Scene::setStropped(bool stopped) { m_Stopped = stopped; }
 
+void Scene::clear()
+{
+    m_Entities.clear();
+    m_MainCamera = Entity();
+    m_PendingDestroy.assign(m_PendingDestroy.size(), false);
+}
+
 void Scene::onInit()
 {
     m_Entities.onConstruct<ScriptComponent>().addHandler<&Scene::onScriptAdded>(*this);
+    m_Entities.onRemove<ScriptComponent>().addHandler<&Scene::onScriptRemoved>(*this);
+    m_Entities.onRemoveBatch<ScriptComponent>().addHandler<&Scene::onScriptsRemoved>(*this);
     m_Entities.onConstruct<CameraComponent>().addHandler<&Scene::onCameraAdded>(*this);
+    m_Entities.onRemove<HierarchyComponent>().addHandler<&Scene::onHierarchyRemoved>(*this);
+    m_Entities.onRemoveBatch<HierarchyComponent>().addHandler<&Scene::onHierarchiesRemoved>(*this);
 
     m_Stopped = false;
 }
@@ -69,6 +149,15 @@ void Scene::onScriptRemoved(const EventComponentRemove<ScriptComponent>& event)
     event.component.nativeScript->onDetach(Entity(event.entityId, m_Entities), m_EventDispatcher);
 }
 
+void Scene::onScriptsRemoved(const EventComponentRemoveBatch<ScriptComponent>& event)
+{
+    for (size_t i = 0; i < event.count; ++i)
+    {
+        event.pool.get(event.entities[i]).nativeScript->onDetach(Entity(event.entities[i], m_Entities),
+                                                                 m_EventDispatcher);
+    }
+}
+
 void Scene::onCameraAdded(const EventComponentConstruct<CameraComponent>& event)
 {
     if (event.component.isMain)
@@ -77,60 +166,32 @@ void Scene::onCameraAdded(const EventComponentConstruct<CameraComponent>& event)
     }
 }
 
-void Scene::onUpdate(float dt)
+void Scene::onHierarchyRemoved(const EventComponentRemove<HierarchyComponent>& event)
 {
-    /* Running native scripts */
-    for (auto [entity, scriptComponent] : getView<ScriptComponent>(m_Entities))
-    {
-        scriptComponent.nativeScript->onUpdate(dt);
-    }
+    unlinkFromHierarchy(m_Entities, event.entityId);
+}
 
-    /* Updating particles */
-    for (auto [entity, particleSystemComponent] : getView<ParticleSystemComponent>(m_Entities))
+void Scene::onHierarchiesRemoved(const EventComponentRemoveBatch<HierarchyComponent>& event)
+{
+    for (size_t i = 0; i < event.count; ++i)
     {
-        particleSystemComponent.particleSystem.onUpdate(dt);
+        unlinkFromHierarchy(m_Entities, event.entities[i]);
     }
+}
 
-    /* Physics simulation TODO: move to a physics scene! */
-    for (auto [entity, physicsComponent] : getView<PhysicsComponent>(m_Entities))
-    {
-        Vec2f acceleration = physicsComponent.force / physicsComponent.mass;
-        physicsComponent.velocity += acceleration * dt;
-
-        entity.getComponent<TransformComponent>().translation += physicsComponent.velocity * dt;
-    }
-
-    for (auto [entity, boundingSphereComponent] : getView<BoundingSphereComponent>(m_Entities))
-    {
-        TransformComponent& transform = entity.getComponent<TransformComponent>();
-
-        boundingSphereComponent.wsTranslation = Vec2f(transform.calculateMatrix()
-                                                      * Vec3f(boundingSphereComponent.msTranslation, 1));
+void Scene::onUpdate(float dt)
+{
+    m_Entities.resetFrameStats();
 
-        boundingSphereComponent.wsRadius = boundingSphereComponent.msRadius
-                                           * std::max(transform.scale.x, transform.scale.y);
-    }
+    m_Scheduler.run(dt);
 
-    for (auto [entity1, boundingSphere1] : getView<BoundingSphereComponent>(m_Entities))
-    {
-        for (auto [entity2, boundingSphere2] : getView<BoundingSphereComponent>(m_Entities))
-        {
-            if (/*TODO: add event queue to prevent order dependency*/ !m_Stopped && (entity1 != entity2)
-                && !isSubmittedToRemove(entity1) && !isSubmittedToRemove(entity2)
-                && boundingSpheresCollide(boundingSphere1, boundingSphere2))
-            {
-                m_EventDispatcher.fireEvent<CollisionEvent>(entity1, entity2);
-            }
-        }
-    }
+    /* Sync point for the events enqueued by systems */
+    m_EventDispatcher.dispatchQueued();
 
-    /* Remove submitted entities */
-    for (auto entity : m_EntitiesToRemove)
-    {
-        entity.destroy();
-    }
+    /* Apply deferred entity creation and destruction */
+    flushCommandBuffers();
 
-    m_EntitiesToRemove.clear();
+    m_TransformSystem->onUpdate(dt);
 }
 
 void Scene::render(Renderer& renderer)
@@ -139,10 +200,8 @@ void Scene::render(Renderer& renderer)
     bool                    mainCameraFound{false};
     OrthographicCameraSpecs mainCameraSpecs;
     Mat3f                   mainCameraViewMatrix;
-    for (auto [camera, component] : getView<CameraComponent>(m_Entities))
+    for (auto [camera, component, transform] : getView<const CameraComponent, const TransformComponent>(m_Entities))
     {
-        assert(camera.hasComponent<TransformComponent>());
-
         if (!component.isMain)
         {
             continue;
@@ -156,7 +215,7 @@ void Scene::render(Renderer& renderer)
         {
             mainCameraFound      = true;
             mainCameraSpecs      = component.cameraSpecs;
-            mainCameraViewMatrix = camera.getComponent<TransformComponent>().calculateInverseMatrix();
+            mainCameraViewMatrix = transform.calculateInverseMatrix();
         }
     }
 
@@ -169,10 +228,9 @@ void Scene::render(Renderer& renderer)
 
     renderer.clear(Color(10, 0, 10, 0));
 
-    for (auto [polygon, component] : getView<PolygonComponent>(m_Entities))
+    for (auto [polygon, component, worldTransform] : m_Renderables)
     {
-        assert(polygon.hasComponent<TransformComponent>());
-        renderer.drawPolygon(component.polygon, polygon.getComponent<TransformComponent>().calculateMatrix());
+        renderer.drawPolygon(component.polygon, worldTransform.matrix);
     }
 
     /* Rendering particles */
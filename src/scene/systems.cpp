@@ -0,0 +1,317 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file systems.cpp
+ * @date 2026-10-16
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "scene/systems.hpp"
+#include "ecs/entity_view.hpp"
+#include <algorithm>
+
+using namespace gwars;
+
+//==================================================================================================
+// ScriptSystem
+//==================================================================================================
+ScriptSystem::ScriptSystem(Scene& scene) : m_Scene(scene) {}
+
+void ScriptSystem::declareAccess(SystemAccess& access) const { access.exclusive(); }
+
+void ScriptSystem::onUpdate(float dt)
+{
+    for (auto [entity, scriptComponent] : getView<const ScriptComponent>(m_Scene.getEntityManager()))
+    {
+        scriptComponent.nativeScript->onUpdate(dt);
+    }
+}
+
+//==================================================================================================
+// ParticleSystemUpdateSystem
+//==================================================================================================
+ParticleSystemUpdateSystem::ParticleSystemUpdateSystem(Scene& scene) : m_Scene(scene) {}
+
+void ParticleSystemUpdateSystem::declareAccess(SystemAccess& access) const
+{
+    access.write<ParticleSystemComponent>();
+}
+
+void ParticleSystemUpdateSystem::onUpdate(float dt)
+{
+    for (auto [entity, particleSystemComponent] : getView<ParticleSystemComponent>(m_Scene.getEntityManager()))
+    {
+        particleSystemComponent.particleSystem.onUpdate(dt);
+    }
+}
+
+//==================================================================================================
+// PhysicsSystem
+//==================================================================================================
+PhysicsSystem::PhysicsSystem(Scene& scene) : m_Scene(scene), m_Bodies(scene.getEntityManager()) {}
+
+void PhysicsSystem::declareAccess(SystemAccess& access) const
+{
+    access.write<PhysicsComponent, TransformComponent>();
+}
+
+/* Only the components the step has actually changed are marked changed, so that bodies at rest don't wake
+ * up change-driven systems every frame. Components are accessed by index to look every entity up once. */
+void PhysicsSystem::onUpdate(float dt)
+{
+    EntityManager&                     entities          = m_Scene.getEntityManager();
+    ComponentPool<PhysicsComponent>&   physicsComponents = entities.getPool<PhysicsComponent>();
+    ComponentPool<TransformComponent>& transforms        = entities.getPool<TransformComponent>();
+
+    const EntityId* bodies = m_Bodies.getEntities();
+    for (size_t i = 0; i < m_Bodies.size(); ++i)
+    {
+        size_t              physicsIndex     = physicsComponents.getIndex(bodies[i]);
+        size_t              transformIndex   = transforms.getIndex(bodies[i]);
+        PhysicsComponent&   physicsComponent = physicsComponents.getComponent(physicsIndex);
+        TransformComponent& transform        = transforms.getComponent(transformIndex);
+
+        Vec2f acceleration = physicsComponent.force / physicsComponent.mass;
+        Vec2f velocity     = physicsComponent.velocity + acceleration * dt;
+        Vec2f translation  = transform.translation + velocity * dt;
+
+        if (!(velocity == physicsComponent.velocity))
+        {
+            physicsComponent.velocity = velocity;
+            physicsComponents.markChanged(physicsIndex);
+        }
+
+        if (!(translation == transform.translation))
+        {
+            transform.translation = translation;
+            transforms.markChanged(transformIndex);
+        }
+    }
+}
+
+//==================================================================================================
+// TransformSystem
+//==================================================================================================
+TransformSystem::TransformSystem(Scene& scene) : m_Scene(scene), m_Entities(scene.getEntityManager()) {}
+
+void TransformSystem::declareAccess(SystemAccess& access) const
+{
+    access.read<TransformComponent, HierarchyComponent>().write<WorldTransformComponent>();
+}
+
+void TransformSystem::onUpdate(float)
+{
+    m_RunVersion = m_Entities.getVersion<WorldTransformComponent>();
+
+    for (auto [entity, transform] : getView<const TransformComponent>(m_Entities,
+                                                                      changed<TransformComponent>(m_TransformVersion)))
+    {
+        updateRoot(entity.getId());
+    }
+
+    for (auto [entity, hierarchy] : getView<const HierarchyComponent>(m_Entities,
+                                                                      changed<HierarchyComponent>(m_HierarchyVersion)))
+    {
+        updateRoot(entity.getId());
+    }
+
+    for (auto [entity, worldTransform] : getView<const WorldTransformComponent>(
+             m_Entities, changed<WorldTransformComponent>(m_WorldTransformVersion)))
+    {
+        updateRoot(entity.getId());
+    }
+
+    m_TransformVersion      = m_Entities.getVersion<TransformComponent>();
+    m_HierarchyVersion      = m_Entities.getVersion<HierarchyComponent>();
+    m_WorldTransformVersion = m_Entities.getVersion<WorldTransformComponent>();
+}
+
+bool TransformSystem::isDirty(EntityId id) const
+{
+    const ComponentPool<TransformComponent>&      transforms      = m_Entities.getPool<TransformComponent>();
+    const ComponentPool<HierarchyComponent>&      hierarchies     = m_Entities.getPool<HierarchyComponent>();
+    const ComponentPool<WorldTransformComponent>& worldTransforms = m_Entities.getPool<WorldTransformComponent>();
+
+    return (transforms.contains(id) && transforms.isChangedSince(id, m_TransformVersion))
+           || (hierarchies.contains(id) && hierarchies.isChangedSince(id, m_HierarchyVersion))
+           || (worldTransforms.contains(id) && worldTransforms.isChangedSince(id, m_WorldTransformVersion));
+}
+
+bool TransformSystem::hasDirtyAncestor(EntityId id) const
+{
+    const ComponentPool<HierarchyComponent>& hierarchies = m_Entities.getPool<HierarchyComponent>();
+
+    for (EntityId ancestor = hierarchies.contains(id) ? hierarchies.get(id).parent : INVALID_ENTITY_ID;
+         ancestor != INVALID_ENTITY_ID;
+         ancestor = hierarchies.get(ancestor).parent)
+    {
+        if (isDirty(ancestor))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void TransformSystem::updateRoot(EntityId id)
+{
+    /* Dirty ancestors update the whole subtree themselves */
+    const ComponentPool<WorldTransformComponent>& worldTransforms = m_Entities.getPool<WorldTransformComponent>();
+    if ((worldTransforms.contains(id) && worldTransforms.isChangedSince(id, m_RunVersion)) || hasDirtyAncestor(id))
+    {
+        return;
+    }
+
+    Mat3f    parentMatrix = WorldTransformComponent().matrix;
+    EntityId parent       = m_Entities.hasComponent<HierarchyComponent>(id)
+                                ? m_Entities.getComponent<const HierarchyComponent>(id).parent
+                                : INVALID_ENTITY_ID;
+
+    if (parent != INVALID_ENTITY_ID && worldTransforms.contains(parent))
+    {
+        parentMatrix = worldTransforms.get(parent).matrix;
+    }
+
+    updateSubtree(id, parentMatrix);
+}
+
+void TransformSystem::updateSubtree(EntityId id, const Mat3f& parentMatrix)
+{
+    Mat3f matrix = parentMatrix;
+    if (m_Entities.hasComponent<TransformComponent>(id))
+    {
+        matrix = parentMatrix * m_Entities.getComponent<const TransformComponent>(id).calculateMatrix();
+    }
+
+    if (m_Entities.hasComponent<WorldTransformComponent>(id))
+    {
+        m_Entities.getComponent<WorldTransformComponent>(id).matrix = matrix;
+    }
+
+    if (!m_Entities.hasComponent<HierarchyComponent>(id))
+    {
+        return;
+    }
+
+    for (EntityId child = m_Entities.getComponent<const HierarchyComponent>(id).firstChild; child != INVALID_ENTITY_ID;
+         child          = m_Entities.getComponent<const HierarchyComponent>(child).nextSibling)
+    {
+        updateSubtree(child, matrix);
+    }
+}
+
+//==================================================================================================
+// BoundingSphereSystem
+//==================================================================================================
+BoundingSphereSystem::BoundingSphereSystem(Scene& scene) : m_Scene(scene) {}
+
+void BoundingSphereSystem::declareAccess(SystemAccess& access) const
+{
+    access.read<WorldTransformComponent>().write<BoundingSphereComponent>();
+}
+
+void BoundingSphereSystem::onUpdate(float)
+{
+    EntityManager& entities = m_Scene.getEntityManager();
+
+    /* Spheres changed elsewhere (e.g. just created) go first, then the ones whose transform has moved */
+    for (auto [entity, boundingSphereComponent, worldTransform] :
+         getView<BoundingSphereComponent, const WorldTransformComponent>(
+             entities, changed<BoundingSphereComponent>(m_BoundingSphereVersion)))
+    {
+        update(boundingSphereComponent, worldTransform);
+    }
+
+    for (auto [entity, boundingSphereComponent, worldTransform] :
+         getView<BoundingSphereComponent, const WorldTransformComponent>(
+             entities, changed<WorldTransformComponent>(m_WorldTransformVersion)))
+    {
+        update(boundingSphereComponent, worldTransform);
+    }
+
+    m_WorldTransformVersion = entities.getVersion<WorldTransformComponent>();
+    m_BoundingSphereVersion = entities.getVersion<BoundingSphereComponent>();
+}
+
+void BoundingSphereSystem::update(BoundingSphereComponent&       boundingSphereComponent,
+                                  const WorldTransformComponent& worldTransform)
+{
+    boundingSphereComponent.wsTranslation = Vec2f(worldTransform.matrix
+                                                  * Vec3f(boundingSphereComponent.msTranslation, 1));
+
+    Vec2f scale                      = worldTransform.getScale();
+    boundingSphereComponent.wsRadius = boundingSphereComponent.msRadius * std::max(scale.x, scale.y);
+}
+
+//==================================================================================================
+// CollisionSystem
+//==================================================================================================
+CollisionSystem::CollisionSystem(Scene& scene) : m_Scene(scene) {}
+
+void CollisionSystem::declareAccess(SystemAccess& access) const { access.exclusive(); }
+
+void CollisionSystem::onUpdate(float)
+{
+    if (m_Scene.isStopped())
+    {
+        return;
+    }
+
+    const ComponentPool<BoundingSphereComponent>& boundingSpheres =
+        m_Scene.getEntityManager().getPool<BoundingSphereComponent>();
+
+    const BoundingSphereComponent* components = boundingSpheres.getComponents();
+    const EntityId*                entities   = boundingSpheres.getEntities();
+    size_t                         count      = boundingSpheres.size();
+
+    /* Every unordered pair is tested once, handlers run at the next Scene's dispatchQueued() */
+    for (size_t i = 0; i < count; ++i)
+    {
+        for (size_t j = i + 1; j < count; ++j)
+        {
+            if (!boundingSpheresCollide(components[i], components[j]))
+            {
+                continue;
+            }
+
+            uint16_t firstLayer  = components[i].collisionLayer;
+            uint16_t secondLayer = components[j].collisionLayer;
+
+            if (firstLayer <= secondLayer)
+            {
+                m_Scene.getEventDispatcher().enqueueEvent<CollisionEvent>(entities[i],
+                                                                          entities[j],
+                                                                          firstLayer,
+                                                                          secondLayer);
+            }
+            else
+            {
+                m_Scene.getEventDispatcher().enqueueEvent<CollisionEvent>(entities[j],
+                                                                          entities[i],
+                                                                          secondLayer,
+                                                                          firstLayer);
+            }
+        }
+    }
+}
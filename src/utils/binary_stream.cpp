@@ -0,0 +1,121 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file binary_stream.cpp
+ * @date 2026-10-16
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "utils/binary_stream.hpp"
+#include <stdio.h>
+#include <string.h>
+
+using namespace gwars;
+
+//==================================================================================================
+// BinaryWriter
+//==================================================================================================
+void BinaryWriter::write(const void* data, size_t size)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    m_Data.insert(m_Data.end(), bytes, bytes + size);
+}
+
+void BinaryWriter::writeBlock(const void* data, size_t size, size_t alignment)
+{
+    size_t padding = (alignment - m_Data.size() % alignment) % alignment;
+    m_Data.resize(m_Data.size() + padding, 0);
+
+    write(data, size);
+}
+
+const std::vector<uint8_t>& BinaryWriter::getData() const { return m_Data; }
+
+bool BinaryWriter::saveToFile(const char* filename) const
+{
+    FILE* file = fopen(filename, "wb");
+    if (file == nullptr)
+    {
+        printf("Failed to open file \"%s\"\n", filename);
+        return false;
+    }
+
+    bool written = fwrite(m_Data.data(), 1, m_Data.size(), file) == m_Data.size();
+    fclose(file);
+
+    if (!written)
+    {
+        printf("Failed to write file \"%s\"\n", filename);
+    }
+
+    return written;
+}
+
+//==================================================================================================
+// BinaryReader
+//==================================================================================================
+BinaryReader::BinaryReader(const void* data, size_t size) : m_Data(static_cast<const uint8_t*>(data)), m_Size(size)
+{
+}
+
+bool BinaryReader::read(void* data, size_t size)
+{
+    const void* block = readBlock(size, 1);
+    if (block == nullptr)
+    {
+        return false;
+    }
+
+    memcpy(data, block, size);
+    return true;
+}
+
+const void* BinaryReader::readBlock(size_t size, size_t alignment)
+{
+    size_t padding = (alignment - m_Offset % alignment) % alignment;
+
+    if (m_Failed || padding > m_Size - m_Offset || size > m_Size - m_Offset - padding)
+    {
+        m_Failed = true;
+        return nullptr;
+    }
+
+    m_Offset += padding;
+    const void* block = m_Data + m_Offset;
+    m_Offset += size;
+
+    return block;
+}
+
+const void* BinaryReader::readArray(uint64_t count, size_t elementSize, size_t alignment)
+{
+    if (m_Failed || (elementSize != 0 && count > (m_Size - m_Offset) / elementSize))
+    {
+        m_Failed = true;
+        return nullptr;
+    }
+
+    return readBlock(count * elementSize, alignment);
+}
+
+bool BinaryReader::isFailed() const { return m_Failed; }
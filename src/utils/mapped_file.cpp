@@ -0,0 +1,85 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file mapped_file.cpp
+ * @date 2026-10-16
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "utils/mapped_file.hpp"
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace gwars;
+
+MappedFile::~MappedFile() { close(); }
+
+bool MappedFile::open(const char* filename)
+{
+    close();
+
+    int file = ::open(filename, O_RDONLY);
+    if (file == -1)
+    {
+        printf("Failed to open file \"%s\"\n", filename);
+        return false;
+    }
+
+    struct stat fileStat;
+    if (fstat(file, &fileStat) == -1 || fileStat.st_size == 0)
+    {
+        printf("Failed to map empty or unreadable file \"%s\"\n", filename);
+        ::close(file);
+        return false;
+    }
+
+    void* data = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    ::close(file);
+
+    if (data == MAP_FAILED)
+    {
+        printf("Failed to map file \"%s\"\n", filename);
+        return false;
+    }
+
+    m_Data = data;
+    m_Size = fileStat.st_size;
+
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (m_Data != nullptr)
+    {
+        munmap(m_Data, m_Size);
+        m_Data = nullptr;
+        m_Size = 0;
+    }
+}
+
+const void* MappedFile::getData() const { return m_Data; }
+size_t      MappedFile::getSize() const { return m_Size; }
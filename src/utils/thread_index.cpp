@@ -0,0 +1,103 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file thread_index.cpp
+ * @date 2026-10-16
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "utils/thread_index.hpp"
+#include <atomic>
+#include <cassert>
+#include <stdio.h>
+#include <stdlib.h>
+
+namespace gwars {
+
+static_assert(MAX_THREADS <= 64, "Thread indices are tracked by a 64-bit mask");
+
+static std::atomic<uint64_t> s_UsedThreadIndices{0};
+
+/* Frees the thread's index when the thread exits */
+struct ThreadIndexHolder
+{
+    uint32_t index{MAX_THREADS};
+
+    ~ThreadIndexHolder()
+    {
+        if (index < MAX_THREADS)
+        {
+            s_UsedThreadIndices.fetch_and(~(uint64_t{1} << index));
+        }
+    }
+};
+
+static thread_local ThreadIndexHolder t_ThreadIndex;
+
+uint32_t getThreadIndex()
+{
+    if (t_ThreadIndex.index == MAX_THREADS)
+    {
+        t_ThreadIndex.index = reserveThreadIndex();
+        if (t_ThreadIndex.index == MAX_THREADS)
+        {
+            fprintf(stderr, "getThreadIndex: more than %u threads are running\n", MAX_THREADS);
+            abort();
+        }
+    }
+
+    return t_ThreadIndex.index;
+}
+
+uint32_t reserveThreadIndex()
+{
+    uint64_t used = s_UsedThreadIndices.load();
+    while (true)
+    {
+        uint64_t free = ~used;
+        if (MAX_THREADS < 64)
+        {
+            free &= (uint64_t{1} << (MAX_THREADS % 64)) - 1;
+        }
+
+        if (free == 0)
+        {
+            return MAX_THREADS;
+        }
+
+        uint32_t index = static_cast<uint32_t>(__builtin_ctzll(free));
+        if (s_UsedThreadIndices.compare_exchange_weak(used, used | (uint64_t{1} << index)))
+        {
+            return index;
+        }
+    }
+}
+
+void bindThreadIndex(uint32_t index)
+{
+    assert(index < MAX_THREADS);
+    assert(t_ThreadIndex.index == MAX_THREADS);
+
+    t_ThreadIndex.index = index;
+}
+
+} // namespace gwars
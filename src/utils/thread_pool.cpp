@@ -0,0 +1,111 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file thread_pool.cpp
+ * @date 2026-10-16
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "utils/thread_pool.hpp"
+#include "utils/thread_index.hpp"
+#include <algorithm>
+#include <stdio.h>
+
+using namespace gwars;
+
+ThreadPool::ThreadPool(size_t threadsCount)
+{
+    m_Threads.reserve(threadsCount);
+    for (size_t i = 0; i < threadsCount; ++i)
+    {
+        /* Every worker gets its thread index now, so that running out of them is reported here rather than
+         * aborting a worker later */
+        uint32_t threadIndex = reserveThreadIndex();
+        if (threadIndex == MAX_THREADS)
+        {
+            printf("ThreadPool: only %zu of %zu workers started, all thread indices are in use\n", i, threadsCount);
+            break;
+        }
+
+        m_Threads.emplace_back(&ThreadPool::workerLoop, this, threadIndex);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stopping = true;
+    }
+
+    m_JobSubmitted.notify_all();
+
+    for (std::thread& thread : m_Threads)
+    {
+        thread.join();
+    }
+}
+
+void ThreadPool::submit(JobFunction function, void* data)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Jobs.push_back(Job{function, data});
+    }
+
+    m_JobSubmitted.notify_one();
+}
+
+size_t ThreadPool::getThreadsCount() const { return m_Threads.size(); }
+
+size_t ThreadPool::getDefaultThreadsCount()
+{
+    /* hardware_concurrency() may return 0 if unknown, every worker also needs its own thread index */
+    size_t coresCount = std::thread::hardware_concurrency();
+    return std::min<size_t>(std::max<size_t>(coresCount, 1) - 1, MAX_THREADS - 1);
+}
+
+void ThreadPool::workerLoop(uint32_t threadIndex)
+{
+    bindThreadIndex(threadIndex);
+
+    while (true)
+    {
+        Job job;
+
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_JobSubmitted.wait(lock, [this]() { return m_Stopping || !m_Jobs.empty(); });
+
+            if (m_Jobs.empty())
+            {
+                return;
+            }
+
+            job = m_Jobs.back();
+            m_Jobs.pop_back();
+        }
+
+        job.function(job.data);
+    }
+}
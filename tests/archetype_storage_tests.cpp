@@ -0,0 +1,192 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file archetype_storage_tests.cpp
+ * @date 2026-10-17
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ecs/archetype_storage.hpp"
+#include <gtest/gtest.h>
+
+using namespace gwars;
+
+namespace {
+
+struct Position
+{
+    float x{0};
+    float y{0};
+};
+
+struct Health
+{
+    int32_t value{0};
+};
+
+/* Counts live instances to check that moves between archetypes neither leak nor double-destroy */
+struct Tracked
+{
+    static int32_t s_AliveCount;
+
+    int32_t value{0};
+
+    Tracked(int32_t value = 0) : value(value) { ++s_AliveCount; }
+    Tracked(Tracked&& other) : value(other.value) { ++s_AliveCount; }
+    ~Tracked() { --s_AliveCount; }
+};
+
+int32_t Tracked::s_AliveCount = 0;
+
+} // namespace
+
+TEST(ArchetypeStorageTests, ComponentsMoveWithEntity)
+{
+    {
+        ArchetypeStorage storage;
+
+        EntityId entity = storage.createEntity(Position{1, 2}, Tracked{3});
+        storage.createComponent<Health>(entity, Health{4});
+
+        EXPECT_EQ(storage.getComponent<Position>(entity).x, 1);
+        EXPECT_EQ(storage.getComponent<Position>(entity).y, 2);
+        EXPECT_EQ(storage.getComponent<Tracked>(entity).value, 3);
+        EXPECT_EQ(storage.getComponent<Health>(entity).value, 4);
+
+        storage.removeComponent<Position>(entity);
+
+        EXPECT_FALSE(storage.hasComponent<Position>(entity));
+        EXPECT_EQ(storage.getComponent<Tracked>(entity).value, 3);
+        EXPECT_EQ(storage.getComponent<Health>(entity).value, 4);
+        EXPECT_EQ(Tracked::s_AliveCount, 1);
+
+        storage.removeComponent<Tracked>(entity);
+        EXPECT_EQ(Tracked::s_AliveCount, 0);
+
+        storage.createComponent<Tracked>(entity, 5);
+        EXPECT_EQ(Tracked::s_AliveCount, 1);
+    }
+
+    EXPECT_EQ(Tracked::s_AliveCount, 0);
+}
+
+TEST(ArchetypeStorageTests, TransitionsReuseArchetypes)
+{
+    ArchetypeStorage storage;
+
+    EntityId entity = storage.createEntity(Position{});
+    storage.createComponent<Health>(entity);
+    storage.removeComponent<Health>(entity);
+
+    /* Different insertion order leads to the same archetype */
+    EntityId other = storage.createEntity(Health{});
+    storage.createComponent<Position>(other);
+
+    const size_t archetypesCount = storage.getArchetypesCount();
+    EXPECT_EQ(archetypesCount, 3u);
+
+    for (int32_t i = 0; i < 100; ++i)
+    {
+        storage.createComponent<Health>(entity, Health{i});
+        EXPECT_EQ(storage.getComponent<Health>(entity).value, i);
+        storage.removeComponent<Health>(entity);
+    }
+
+    EXPECT_EQ(storage.getArchetypesCount(), archetypesCount);
+}
+
+TEST(ArchetypeStorageTests, SwapRemoveFixesUpMovedRows)
+{
+    ArchetypeStorage      storage;
+    std::vector<EntityId> entities;
+
+    /* Enough entities to span several chunks, so that rows are also moved between chunks */
+    const int32_t count = 3000;
+    for (int32_t i = 0; i < count; ++i)
+    {
+        entities.push_back(storage.createEntity(Health{i}, Tracked{i}));
+    }
+
+    for (int32_t i = 0; i < count; i += 3)
+    {
+        storage.removeEntity(entities[i]);
+    }
+
+    for (int32_t i = 1; i < count; i += 3)
+    {
+        storage.removeComponent<Tracked>(entities[i]);
+    }
+
+    for (int32_t i = 0; i < count; ++i)
+    {
+        if (i % 3 == 0)
+        {
+            EXPECT_FALSE(storage.isAlive(entities[i]));
+            continue;
+        }
+
+        ASSERT_TRUE(storage.isAlive(entities[i]));
+        EXPECT_EQ(storage.getComponent<Health>(entities[i]).value, i);
+        EXPECT_EQ(storage.hasComponent<Tracked>(entities[i]), i % 3 == 2);
+    }
+
+    size_t visited = 0;
+    storage.forEach<Health, Tracked>([&](EntityId entity, Health& health, Tracked& tracked) {
+        EXPECT_EQ(health.value, tracked.value);
+        EXPECT_EQ(storage.getComponent<Health>(entity).value, health.value);
+        ++visited;
+    });
+
+    EXPECT_EQ(visited, count / 3);
+    EXPECT_EQ(Tracked::s_AliveCount, count / 3);
+
+    storage.clear();
+    EXPECT_EQ(Tracked::s_AliveCount, 0);
+}
+
+TEST(ArchetypeStorageTests, ShrinkingFreesChunks)
+{
+    Archetype archetype({ComponentColumnInfo::create<Position>()});
+
+    const uint32_t capacity = archetype.getChunkCapacity();
+    for (uint32_t i = 0; i < 3 * capacity; ++i)
+    {
+        new (archetype.getComponent(archetype.allocateRow(makeEntityId(i + 1, 1)), 0)) Position{};
+    }
+
+    EXPECT_EQ(archetype.getAllocatedChunksCount(), 3u);
+
+    /* One spare chunk is kept */
+    while (archetype.size() > capacity)
+    {
+        archetype.removeRow(0);
+    }
+
+    EXPECT_EQ(archetype.getChunksCount(), 1u);
+    EXPECT_EQ(archetype.getAllocatedChunksCount(), 2u);
+
+    archetype.removeRow(0);
+    EXPECT_EQ(archetype.getAllocatedChunksCount(), 2u);
+
+    archetype.clear();
+    EXPECT_EQ(archetype.getAllocatedChunksCount(), 0u);
+}
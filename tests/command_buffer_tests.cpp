@@ -0,0 +1,206 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file command_buffer_tests.cpp
+ * @date 2026-10-17
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ecs/command_buffer.hpp"
+#include "scene/scene.hpp"
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace gwars;
+
+namespace {
+
+struct Tag
+{
+    uint32_t value{0};
+};
+
+struct Marker
+{
+};
+
+} // namespace
+
+TEST(CommandBufferTests, PlaceholdersResolveToCreatedEntities)
+{
+    EntityManager manager;
+    CommandBuffer commands;
+
+    EntityId first  = commands.createEntity();
+    EntityId second = commands.createEntity();
+    EXPECT_TRUE(CommandBuffer::isPlaceholder(first));
+    EXPECT_FALSE(manager.isAlive(first));
+
+    commands.createComponent<Tag>(second, Tag{2});
+    commands.createComponent<Tag>(first, Tag{1});
+    commands.flush(manager);
+
+    ComponentPool<Tag>& tags = manager.getPool<Tag>();
+    ASSERT_EQ(tags.size(), 2u);
+    EXPECT_EQ(tags.get(tags.getEntity(0)).value + tags.get(tags.getEntity(1)).value, 3u);
+    EXPECT_TRUE(commands.empty());
+}
+
+/* Placeholders used to be numbered by the 12-bit generation, which capped a flush at 4095 entities */
+TEST(CommandBufferTests, ManyPlaceholdersPerFlush)
+{
+    constexpr uint32_t COUNT = 10000;
+
+    EntityManager manager;
+    CommandBuffer commands;
+
+    for (uint32_t i = 0; i < COUNT; ++i)
+    {
+        commands.createComponent<Tag>(commands.createEntity(), Tag{i});
+    }
+
+    commands.flush(manager);
+
+    ComponentPool<Tag>& tags = manager.getPool<Tag>();
+    ASSERT_EQ(tags.size(), COUNT);
+
+    std::vector<bool> seen(COUNT, false);
+    for (size_t i = 0; i < tags.size(); ++i)
+    {
+        uint32_t value = tags.getComponents()[i].value;
+        ASSERT_LT(value, COUNT);
+        EXPECT_FALSE(seen[value]);
+        seen[value] = true;
+    }
+}
+
+TEST(CommandBufferTests, CommandsApplyInRecordedOrder)
+{
+    EntityManager manager;
+    CommandBuffer commands;
+
+    EntityId destroyedLast  = manager.createEntity();
+    EntityId destroyedFirst = manager.createEntity();
+
+    commands.createComponent<Tag>(destroyedLast, Tag{1});
+    commands.destroyEntity(destroyedLast);
+
+    commands.destroyEntity(destroyedFirst);
+    commands.createComponent<Tag>(destroyedFirst, Tag{2});
+    commands.removeComponent<Marker>(destroyedFirst);
+
+    commands.flush(manager);
+
+    EXPECT_FALSE(manager.isAlive(destroyedLast));
+    EXPECT_FALSE(manager.isAlive(destroyedFirst));
+    EXPECT_EQ(manager.getPool<Tag>().size(), 0u);
+}
+
+TEST(CommandBufferTests, CommandsForDeadEntitiesAreSkipped)
+{
+    EntityManager manager;
+    CommandBuffer commands;
+
+    EntityId dead = manager.createEntity();
+    manager.removeEntity(dead);
+
+    /* The slot is reused, the old handle must not reach the new entity */
+    EntityId reused = manager.createEntity();
+    ASSERT_EQ(getEntityIndex(reused), getEntityIndex(dead));
+
+    commands.createComponent<Tag>(dead, Tag{1});
+    commands.removeComponent<Tag>(dead);
+    commands.destroyEntity(dead);
+    commands.flush(manager);
+
+    EXPECT_TRUE(manager.isAlive(reused));
+    EXPECT_FALSE(manager.hasComponent<Tag>(reused));
+}
+
+struct MarkingHandler
+{
+    CommandBuffer* commands{nullptr};
+
+    void onTagConstructed(const EventComponentConstruct<Tag>& event)
+    {
+        commands->createComponent<Marker>(event.entityId);
+    }
+};
+
+TEST(CommandBufferTests, CommandsRecordedWhileFlushingAreApplied)
+{
+    EntityManager manager;
+    CommandBuffer commands;
+
+    MarkingHandler   handler{&commands};
+    ScopedConnection connection(manager.onConstruct<Tag>().addHandler<&MarkingHandler::onTagConstructed>(handler));
+
+    EntityId placeholder = commands.createEntity();
+    commands.createComponent<Tag>(placeholder);
+    commands.flush(manager);
+
+    ComponentPool<Tag>& tags = manager.getPool<Tag>();
+    ASSERT_EQ(tags.size(), 1u);
+    EXPECT_TRUE(manager.hasComponent<Marker>(tags.getEntity(0)));
+    EXPECT_TRUE(commands.empty());
+}
+
+/* Every thread records into its own buffer with its own placeholders, the scene applies them all */
+TEST(CommandBufferTests, PerThreadBuffersAreMerged)
+{
+    constexpr uint32_t THREADS_COUNT  = 3;
+    constexpr uint32_t ENTITIES_COUNT = 100;
+
+    EventDispatcher dispatcher;
+    Scene           scene(dispatcher);
+
+    std::vector<std::thread> threads;
+    for (uint32_t thread = 0; thread < THREADS_COUNT; ++thread)
+    {
+        threads.emplace_back([&scene, thread]() {
+            CommandBuffer& commands = scene.getCommandBuffer();
+            for (uint32_t i = 0; i < ENTITIES_COUNT; ++i)
+            {
+                commands.createComponent<Tag>(commands.createEntity(), Tag{thread * ENTITIES_COUNT + i});
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    scene.flushCommandBuffers();
+
+    ComponentPool<Tag>& tags = scene.getEntityManager().getPool<Tag>();
+    ASSERT_EQ(tags.size(), THREADS_COUNT * ENTITIES_COUNT);
+
+    std::vector<bool> seen(THREADS_COUNT * ENTITIES_COUNT, false);
+    for (size_t i = 0; i < tags.size(); ++i)
+    {
+        uint32_t value = tags.getComponents()[i].value;
+        ASSERT_LT(value, seen.size());
+        EXPECT_FALSE(seen[value]);
+        seen[value] = true;
+    }
+}
@@ -0,0 +1,167 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file component_pool_tests.cpp
+ * @date 2026-10-17
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ecs/entity_manager.hpp"
+#include <gtest/gtest.h>
+
+using namespace gwars;
+
+namespace {
+
+struct Health
+{
+    int32_t value{0};
+};
+
+struct RemovedHealthRecorder
+{
+    std::vector<int32_t> values;
+
+    void onHealthRemoved(const EventComponentRemove<Health>& event) { values.push_back(event.component.value); }
+};
+
+} // namespace
+
+static std::vector<EntityId> createWithHealth(EntityManager& manager, int32_t count)
+{
+    std::vector<EntityId> entities;
+    for (int32_t i = 0; i < count; ++i)
+    {
+        entities.push_back(manager.createEntity());
+        manager.createComponent<Health>(entities.back(), Health{i});
+    }
+
+    return entities;
+}
+
+TEST(ComponentPoolTests, ComponentsAreDenseAndOrderedAsEntities)
+{
+    EntityManager         manager;
+    std::vector<EntityId> entities = createWithHealth(manager, 4);
+    ComponentPool<Health>& pool    = manager.getPool<Health>();
+
+    ASSERT_EQ(pool.size(), 4u);
+    for (size_t i = 0; i < pool.size(); ++i)
+    {
+        EXPECT_EQ(pool.getEntities()[i], entities[i]);
+        EXPECT_EQ(pool.getIndex(entities[i]), i);
+        EXPECT_EQ(pool.getComponents()[i].value, static_cast<int32_t>(i));
+    }
+}
+
+TEST(ComponentPoolTests, RemovalMovesLastElementIntoHole)
+{
+    EntityManager          manager;
+    std::vector<EntityId>  entities = createWithHealth(manager, 4);
+    ComponentPool<Health>& pool     = manager.getPool<Health>();
+
+    manager.removeComponent<Health>(entities[1]);
+
+    ASSERT_EQ(pool.size(), 3u);
+    EXPECT_FALSE(pool.contains(entities[1]));
+    EXPECT_FALSE(manager.hasComponent<Health>(entities[1]));
+
+    EXPECT_EQ(pool.getEntity(1), entities[3]);
+    EXPECT_EQ(pool.getIndex(entities[3]), 1u);
+    EXPECT_EQ(pool.get(entities[3]).value, 3);
+    EXPECT_EQ(pool.get(entities[0]).value, 0);
+    EXPECT_EQ(pool.get(entities[2]).value, 2);
+
+    /* Removing the last element doesn't move anything */
+    manager.removeComponent<Health>(entities[2]);
+    EXPECT_EQ(pool.getIndex(entities[3]), 1u);
+    EXPECT_EQ(pool.size(), 2u);
+}
+
+TEST(ComponentPoolTests, RemoveEventSeesComponent)
+{
+    EntityManager         manager;
+    std::vector<EntityId> entities = createWithHealth(manager, 3);
+
+    RemovedHealthRecorder recorder;
+    ScopedConnection      connection(
+        manager.onRemove<Health>().addHandler<&RemovedHealthRecorder::onHealthRemoved>(recorder));
+
+    manager.removeComponent<Health>(entities[0]);
+    manager.removeEntity(entities[2]);
+
+    EXPECT_EQ(recorder.values, (std::vector<int32_t>{0, 2}));
+}
+
+TEST(ComponentPoolTests, StaleHandleDoesNotMatchReusedSlot)
+{
+    EntityManager manager;
+
+    EntityId stale = manager.createEntity();
+    manager.createComponent<Health>(stale, Health{1});
+    manager.removeEntity(stale);
+
+    EntityId reused = manager.createEntity();
+    manager.createComponent<Health>(reused, Health{2});
+
+    ASSERT_EQ(getEntityIndex(reused), getEntityIndex(stale));
+    EXPECT_FALSE(manager.getPool<Health>().contains(stale));
+    EXPECT_TRUE(manager.getPool<Health>().contains(reused));
+}
+
+TEST(ComponentPoolTests, ChangesAreVersioned)
+{
+    EntityManager          manager;
+    std::vector<EntityId>  entities = createWithHealth(manager, 3);
+    ComponentPool<Health>& pool     = manager.getPool<Health>();
+
+    uint64_t version = pool.getVersion();
+    EXPECT_FALSE(pool.isChangedSince(entities[0], version));
+
+    pool.modify(entities[1]).value = 10;
+    pool.get(entities[2]).value    = 20;
+
+    EXPECT_FALSE(pool.isChangedSince(entities[0], version));
+    EXPECT_TRUE(pool.isChangedSince(entities[1], version));
+    EXPECT_FALSE(pool.isChangedSince(entities[2], version));
+    EXPECT_GT(pool.getVersion(), version);
+}
+
+TEST(ComponentPoolTests, ReservedPoolDoesNotAllocate)
+{
+    EntityManager manager;
+    manager.reserveEntities(256);
+    manager.reserve<Health>(256);
+
+    const size_t allocationsCount = manager.getAllocationsCount();
+
+    for (int32_t round = 0; round < 4; ++round)
+    {
+        std::vector<EntityId> entities = createWithHealth(manager, 256);
+        for (EntityId id : entities)
+        {
+            manager.removeEntity(id);
+        }
+    }
+
+    EXPECT_EQ(manager.getAllocationsCount(), allocationsCount);
+}
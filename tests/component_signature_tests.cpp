@@ -0,0 +1,137 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file component_signature_tests.cpp
+ * @date 2026-10-17
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ecs/entity_manager.hpp"
+#include <gtest/gtest.h>
+
+using namespace gwars;
+
+namespace {
+
+struct Position
+{
+};
+
+struct Velocity
+{
+};
+
+struct Hidden
+{
+};
+
+} // namespace
+
+TEST(ComponentSignatureTests, SetResetAndTest)
+{
+    ComponentSignature signature;
+    EXPECT_FALSE(signature.any());
+    EXPECT_EQ(signature.first(), INVALID_COMPONENT_ID);
+
+    /* Bits in both words */
+    signature.set(3);
+    signature.set(64);
+    signature.set(MAX_COMPONENT_TYPES - 1);
+
+    EXPECT_TRUE(signature.test(3));
+    EXPECT_TRUE(signature.test(64));
+    EXPECT_TRUE(signature.test(MAX_COMPONENT_TYPES - 1));
+    EXPECT_FALSE(signature.test(4));
+    EXPECT_EQ(signature.first(), 3u);
+
+    signature.reset(3);
+    EXPECT_FALSE(signature.test(3));
+    EXPECT_EQ(signature.first(), 64u);
+
+    signature.clear();
+    EXPECT_FALSE(signature.any());
+}
+
+TEST(ComponentSignatureTests, ContainsAndIntersects)
+{
+    ComponentSignature entity;
+    entity.set(1);
+    entity.set(70);
+
+    ComponentSignature mask;
+    mask.set(70);
+    EXPECT_TRUE(entity.contains(mask));
+    EXPECT_TRUE(entity.intersects(mask));
+
+    mask.set(2);
+    EXPECT_FALSE(entity.contains(mask));
+    EXPECT_TRUE(entity.intersects(mask));
+
+    ComponentSignature disjoint;
+    disjoint.set(100);
+    EXPECT_FALSE(entity.intersects(disjoint));
+
+    /* Every set contains the empty one */
+    EXPECT_TRUE(entity.contains(ComponentSignature{}));
+    EXPECT_FALSE(entity.intersects(ComponentSignature{}));
+
+    ComponentSignature merged = mask;
+    merged.merge(disjoint);
+    EXPECT_TRUE(merged.contains(mask));
+    EXPECT_TRUE(merged.contains(disjoint));
+}
+
+TEST(ComponentSignatureTests, EqualityAndHash)
+{
+    ComponentSignature lhs = ComponentSignature::create<Position, Velocity>();
+    ComponentSignature rhs = ComponentSignature::create<Velocity, Position>();
+
+    EXPECT_EQ(lhs, rhs);
+    EXPECT_EQ(lhs.hash(), rhs.hash());
+
+    rhs.set(ComponentType<Hidden>::getId());
+    EXPECT_NE(lhs, rhs);
+}
+
+TEST(ComponentSignatureTests, EntitySignatureFollowsComponents)
+{
+    EntityManager manager;
+    EntityId      id = manager.createEntity();
+
+    EXPECT_FALSE(manager.getSignature(id).any());
+
+    manager.createComponent<Position>(id);
+    manager.createComponent<Velocity>(id);
+    EXPECT_EQ(manager.getSignature(id), (ComponentSignature::create<Position, Velocity>()));
+    EXPECT_TRUE(manager.hasComponent<Position>(id));
+    EXPECT_FALSE(manager.hasComponent<Hidden>(id));
+
+    manager.removeComponent<Position>(id);
+    EXPECT_EQ(manager.getSignature(id), ComponentSignature::create<Velocity>());
+    EXPECT_FALSE(manager.hasComponent<Position>(id));
+
+    /* A reused slot starts with an empty signature */
+    manager.removeEntity(id);
+    EntityId reused = manager.createEntity();
+    ASSERT_EQ(getEntityIndex(reused), getEntityIndex(id));
+    EXPECT_FALSE(manager.getSignature(reused).any());
+}
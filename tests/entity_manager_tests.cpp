@@ -0,0 +1,239 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file entity_manager_tests.cpp
+ * @date 2026-10-17
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ecs/entity_manager.hpp"
+#include <gtest/gtest.h>
+
+using namespace gwars;
+
+namespace {
+
+struct Health
+{
+    int32_t value{0};
+};
+
+struct RemovalRecorder
+{
+    size_t               removedCount{0};
+    size_t               batchesCount{0};
+    std::vector<int32_t> batchValues;
+
+    void onRemove(const EventComponentRemove<Health>&) { ++removedCount; }
+
+    void onRemoveBatch(const EventComponentRemoveBatch<Health>& event)
+    {
+        ++batchesCount;
+        for (size_t i = 0; i < event.count; ++i)
+        {
+            batchValues.push_back(event.pool.get(event.entities[i]).value);
+        }
+    }
+};
+
+} // namespace
+
+static std::vector<EntityId> createWithHealth(EntityManager& manager, int32_t count)
+{
+    std::vector<EntityId> entities;
+    for (int32_t i = 0; i < count; ++i)
+    {
+        entities.push_back(manager.createEntity());
+        manager.createComponent<Health>(entities.back(), Health{i});
+    }
+
+    return entities;
+}
+
+static_assert(sizeof(EntityId) == 4, "Entity handles are meant to be stored in components and events");
+
+TEST(EntityManagerTests, ReleasedSlotsAreReusedWithNewGeneration)
+{
+    EntityManager manager;
+
+    EntityId first  = manager.createEntity();
+    EntityId second = manager.createEntity();
+    manager.removeEntity(first);
+
+    EXPECT_FALSE(manager.isAlive(first));
+    EXPECT_TRUE(manager.isAlive(second));
+
+    EntityId reused = manager.createEntity();
+    EXPECT_EQ(getEntityIndex(reused), getEntityIndex(first));
+    EXPECT_EQ(getEntityGeneration(reused), getEntityGeneration(first) + 1);
+
+    EXPECT_TRUE(manager.isAlive(reused));
+    EXPECT_FALSE(manager.isAlive(first));
+}
+
+TEST(EntityManagerTests, InvalidHandlesAreNotAlive)
+{
+    EntityManager manager;
+    manager.createEntity();
+
+    EXPECT_FALSE(manager.isAlive(INVALID_ENTITY_ID));
+    EXPECT_FALSE(manager.isAlive(makeEntityId(1000, 0)));
+    EXPECT_FALSE(manager.isAlive(makeEntityId(1, 1)));
+}
+
+TEST(EntityManagerTests, SlotsStayDense)
+{
+    EntityManager         manager;
+    std::vector<EntityId> entities;
+
+    for (int32_t round = 0; round < 100; ++round)
+    {
+        for (int32_t i = 0; i < 10; ++i)
+        {
+            entities.push_back(manager.createEntity());
+        }
+
+        for (EntityId id : entities)
+        {
+            manager.removeEntity(id);
+        }
+
+        entities.clear();
+    }
+
+    EXPECT_EQ(manager.getStats().slotsCount, 10u);
+}
+
+/* A slot is released MAX_ENTITY_GENERATION times, then its generation would wrap around to a value of
+ * a stale handle, so it must not be reused */
+TEST(EntityManagerTests, SlotRetiresBeforeGenerationWraps)
+{
+    EntityManager         manager;
+    std::vector<EntityId> handles;
+
+    EntityId id    = manager.createEntity();
+    uint32_t index = getEntityIndex(id);
+
+    while (getEntityIndex(id) == index)
+    {
+        ASSERT_LE(getEntityGeneration(id), MAX_ENTITY_GENERATION);
+        handles.push_back(id);
+
+        manager.removeEntity(id);
+        id = manager.createEntity();
+    }
+
+    EXPECT_EQ(handles.size(), MAX_ENTITY_GENERATION + 1);
+    EXPECT_EQ(getEntityGeneration(handles.back()), MAX_ENTITY_GENERATION);
+
+    for (EntityId handle : handles)
+    {
+        EXPECT_FALSE(manager.isAlive(handle));
+    }
+
+    EXPECT_EQ(manager.getStats().entitiesCount, 1u);
+}
+
+TEST(EntityManagerTests, ClearRetiresExhaustedSlots)
+{
+    EntityManager manager;
+
+    EntityId id = manager.createEntity();
+    while (getEntityGeneration(id) < MAX_ENTITY_GENERATION)
+    {
+        manager.removeEntity(id);
+        id = manager.createEntity();
+    }
+
+    EntityId other = manager.createEntity();
+    manager.createComponent<Health>(id);
+    manager.clear();
+
+    EXPECT_FALSE(manager.isAlive(id));
+    EXPECT_FALSE(manager.isAlive(other));
+
+    EntityId created = manager.createEntity();
+    EXPECT_NE(getEntityIndex(created), getEntityIndex(id));
+    EXPECT_FALSE(manager.isAlive(id));
+    EXPECT_EQ(manager.getStats().entitiesCount, 1u);
+}
+
+TEST(EntityManagerTests, DestroyEntitiesSkipsRepeatedAndDeadIds)
+{
+    EntityManager         manager;
+    std::vector<EntityId> entities = createWithHealth(manager, 6);
+
+    manager.removeEntity(entities[5]);
+
+    RemovalRecorder  recorder;
+    ScopedConnection removeConnection(manager.onRemove<Health>().addHandler<&RemovalRecorder::onRemove>(recorder));
+    ScopedConnection batchConnection(
+        manager.onRemoveBatch<Health>().addHandler<&RemovalRecorder::onRemoveBatch>(recorder));
+
+    const EntityId ids[] = {entities[1], entities[3], entities[1], entities[5], entities[3], INVALID_ENTITY_ID};
+    manager.destroyEntities(ids, sizeof(ids) / sizeof(ids[0]));
+
+    EXPECT_EQ(recorder.removedCount, 0u);
+    EXPECT_EQ(recorder.batchesCount, 1u);
+    EXPECT_EQ(recorder.batchValues, (std::vector<int32_t>{1, 3}));
+
+    EXPECT_FALSE(manager.isAlive(entities[1]));
+    EXPECT_FALSE(manager.isAlive(entities[3]));
+    EXPECT_EQ(manager.getPool<Health>().size(), 3u);
+    EXPECT_EQ(manager.getStats().entitiesCount, 3u);
+
+    /* Every destroyed slot is released once, so no two new entities share one */
+    EntityId first  = manager.createEntity();
+    EntityId second = manager.createEntity();
+    EntityId third  = manager.createEntity();
+    EXPECT_NE(getEntityIndex(first), getEntityIndex(second));
+    EXPECT_NE(getEntityIndex(second), getEntityIndex(third));
+    EXPECT_NE(getEntityIndex(first), getEntityIndex(third));
+    EXPECT_EQ(manager.getStats().slotsCount, 6u);
+}
+
+TEST(EntityManagerTests, ClearFiresOneBatchPerPool)
+{
+    EntityManager         manager;
+    std::vector<EntityId> entities = createWithHealth(manager, 100);
+
+    RemovalRecorder  recorder;
+    ScopedConnection removeConnection(manager.onRemove<Health>().addHandler<&RemovalRecorder::onRemove>(recorder));
+    ScopedConnection batchConnection(
+        manager.onRemoveBatch<Health>().addHandler<&RemovalRecorder::onRemoveBatch>(recorder));
+
+    manager.clear();
+
+    EXPECT_EQ(recorder.removedCount, 0u);
+    EXPECT_EQ(recorder.batchesCount, 1u);
+    EXPECT_EQ(recorder.batchValues.size(), 100u);
+
+    EXPECT_EQ(manager.getPool<Health>().size(), 0u);
+    EXPECT_EQ(manager.getStats().entitiesCount, 0u);
+    for (EntityId id : entities)
+    {
+        EXPECT_FALSE(manager.isAlive(id));
+    }
+
+    /* Slots are reused from the lowest index */
+    EXPECT_EQ(getEntityIndex(manager.createEntity()), getEntityIndex(entities[0]));
+}
@@ -0,0 +1,159 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file entity_view_tests.cpp
+ * @date 2026-10-17
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ecs/entity_view.hpp"
+#include <algorithm>
+#include <gtest/gtest.h>
+
+using namespace gwars;
+
+namespace {
+
+struct Position
+{
+    int32_t value{0};
+};
+
+struct Velocity
+{
+    int32_t value{0};
+};
+
+struct Hidden
+{
+};
+
+} // namespace
+
+/* Every entity i gets Position{i}, every even one Velocity{-i}, every third one Hidden */
+static std::vector<EntityId> createEntities(EntityManager& manager, int32_t count)
+{
+    std::vector<EntityId> entities;
+    for (int32_t i = 0; i < count; ++i)
+    {
+        EntityId id = manager.createEntity();
+        manager.createComponent<Position>(id, Position{i});
+
+        if (i % 2 == 0)
+        {
+            manager.createComponent<Velocity>(id, Velocity{-i});
+        }
+
+        if (i % 3 == 0)
+        {
+            manager.createComponent<Hidden>(id);
+        }
+
+        entities.push_back(id);
+    }
+
+    return entities;
+}
+
+TEST(EntityViewTests, VisitsEntitiesWithAllComponents)
+{
+    EntityManager manager;
+    createEntities(manager, 12);
+
+    std::vector<int32_t> visited;
+    for (auto [entity, position, velocity] : getView<Position, Velocity>(manager))
+    {
+        EXPECT_EQ(velocity.value, -position.value);
+        EXPECT_EQ(&position, &manager.getPool<Position>().get(entity.getId()));
+        visited.push_back(position.value);
+    }
+
+    std::sort(visited.begin(), visited.end());
+    EXPECT_EQ(visited, (std::vector<int32_t>{0, 2, 4, 6, 8, 10}));
+}
+
+TEST(EntityViewTests, IsDrivenBySmallestPool)
+{
+    EntityManager manager;
+    createEntities(manager, 12);
+
+    EXPECT_EQ((getView<Position, Velocity>(manager).sizeHint()), 6u);
+    EXPECT_EQ((getView<Velocity, Position>(manager).sizeHint()), 6u);
+    EXPECT_EQ((getView<Position, Hidden>(manager).sizeHint()), 4u);
+}
+
+TEST(EntityViewTests, SkipsExcludedComponents)
+{
+    EntityManager manager;
+    createEntities(manager, 12);
+
+    std::vector<int32_t> visited;
+    for (auto [entity, position, velocity] : getView<const Position, const Velocity>(manager, exclude<Hidden>))
+    {
+        visited.push_back(position.value);
+    }
+
+    std::sort(visited.begin(), visited.end());
+    EXPECT_EQ(visited, (std::vector<int32_t>{2, 4, 8, 10}));
+}
+
+TEST(EntityViewTests, OnlyWritableComponentsAreMarkedChanged)
+{
+    EntityManager         manager;
+    std::vector<EntityId> entities = createEntities(manager, 4);
+
+    const uint64_t positionVersion = manager.getVersion<Position>();
+    const uint64_t velocityVersion = manager.getVersion<Velocity>();
+
+    for (auto [entity, position, velocity] : getView<Position, const Velocity>(manager))
+    {
+        position.value += velocity.value;
+    }
+
+    EXPECT_TRUE(manager.getPool<Position>().isChangedSince(entities[2], positionVersion));
+    EXPECT_FALSE(manager.getPool<Position>().isChangedSince(entities[1], positionVersion));
+    EXPECT_EQ(manager.getVersion<Velocity>(), velocityVersion);
+
+    size_t changedCount = 0;
+    for (auto [entity, position] : getView<const Position>(manager, changed<Position>(positionVersion)))
+    {
+        EXPECT_EQ(position.value, 0);
+        ++changedCount;
+    }
+
+    EXPECT_EQ(changedCount, 2u);
+}
+
+TEST(EntityViewTests, DestroyAllRemovesOnlyViewedEntities)
+{
+    EntityManager         manager;
+    std::vector<EntityId> entities = createEntities(manager, 12);
+
+    destroyAll(getView<Velocity>(manager, exclude<Hidden>));
+
+    for (int32_t i = 0; i < 12; ++i)
+    {
+        EXPECT_EQ(manager.isAlive(entities[i]), i % 2 != 0 || i % 3 == 0);
+    }
+
+    EXPECT_EQ(manager.getPool<Velocity>().size(), 2u);
+}
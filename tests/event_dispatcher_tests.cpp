@@ -0,0 +1,271 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file event_dispatcher_tests.cpp
+ * @date 2026-10-17
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "events/event_dispatcher.hpp"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace gwars;
+
+struct PostedEvent
+{
+    uint32_t producer;
+    uint32_t number;
+};
+
+/* Checks that every producer's events arrive once and in order */
+struct PostedEventsReceiver
+{
+    std::vector<uint32_t> nextNumbers;
+    size_t                receivedCount{0};
+    size_t                failuresCount{0};
+
+    explicit PostedEventsReceiver(size_t producersCount) : nextNumbers(producersCount, 0) {}
+
+    void onPosted(const PostedEvent& event)
+    {
+        if (event.producer >= nextNumbers.size() || event.number != nextNumbers[event.producer])
+        {
+            ++failuresCount;
+            return;
+        }
+
+        ++nextNumbers[event.producer];
+        ++receivedCount;
+    }
+};
+
+template<int N>
+struct LateEvent
+{
+};
+
+template<int... Ns>
+static std::vector<void (*)(EventDispatcher&)> getLateSinkCreators(std::integer_sequence<int, Ns...>)
+{
+    return {[](EventDispatcher& dispatcher) { dispatcher.getSink<LateEvent<Ns>>(); }...};
+}
+
+TEST(EventDispatcherTests, PostedEventsAreFiredOnDispatchQueued)
+{
+    EventDispatcher         dispatcher;
+    EventSink<PostedEvent>& sink = dispatcher.enablePosting<PostedEvent>(16);
+
+    PostedEventsReceiver receiver(1);
+    ScopedConnection     connection(sink.addHandler<&PostedEventsReceiver::onPosted>(receiver));
+
+    EXPECT_TRUE(sink.postEvent(PostedEvent{0, 0}));
+    EXPECT_TRUE(sink.postEvent(PostedEvent{0, 1}));
+    EXPECT_TRUE(sink.postEvent(PostedEvent{0, 2}));
+    EXPECT_EQ(receiver.receivedCount, 0u);
+
+    dispatcher.dispatchQueued();
+    EXPECT_EQ(receiver.receivedCount, 3u);
+
+    dispatcher.dispatchQueued();
+    EXPECT_EQ(receiver.receivedCount, 3u);
+    EXPECT_EQ(receiver.failuresCount, 0u);
+}
+
+TEST(EventDispatcherTests, FullPostedQueueDropsEvents)
+{
+    EventDispatcher         dispatcher;
+    EventSink<PostedEvent>& sink = dispatcher.enablePosting<PostedEvent>(2);
+
+    PostedEventsReceiver receiver(1);
+    ScopedConnection     connection(sink.addHandler<&PostedEventsReceiver::onPosted>(receiver));
+
+    EXPECT_TRUE(sink.postEvent(PostedEvent{0, 0}));
+    EXPECT_TRUE(sink.postEvent(PostedEvent{0, 1}));
+    EXPECT_FALSE(sink.postEvent(PostedEvent{0, 2}));
+
+    dispatcher.dispatchQueued();
+    EXPECT_EQ(receiver.receivedCount, 2u);
+    EXPECT_EQ(receiver.failuresCount, 0u);
+}
+
+/* Creating sinks grows the dispatcher's sink array, which threads posting through their sinks must not touch */
+TEST(EventDispatcherTests, PostingWhileSinksAreCreated)
+{
+    constexpr uint32_t PRODUCERS_COUNT = 4;
+    constexpr uint32_t POSTS_COUNT     = 5000;
+
+    EventDispatcher         dispatcher;
+    EventSink<PostedEvent>& sink = dispatcher.enablePosting<PostedEvent>(64);
+
+    PostedEventsReceiver receiver(PRODUCERS_COUNT);
+    ScopedConnection     connection(sink.addHandler<&PostedEventsReceiver::onPosted>(receiver));
+
+    std::vector<std::thread> producers;
+    for (uint32_t producer = 0; producer < PRODUCERS_COUNT; ++producer)
+    {
+        producers.emplace_back([&sink, producer]() {
+            for (uint32_t number = 0; number < POSTS_COUNT; ++number)
+            {
+                while (!sink.postEvent(PostedEvent{producer, number}))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::vector<void (*)(EventDispatcher&)> sinkCreators = getLateSinkCreators(std::make_integer_sequence<int, 64>());
+    size_t                                  createdCount = 0;
+
+    while (receiver.receivedCount + receiver.failuresCount < PRODUCERS_COUNT * POSTS_COUNT)
+    {
+        if (createdCount < sinkCreators.size())
+        {
+            sinkCreators[createdCount++](dispatcher);
+        }
+
+        dispatcher.dispatchQueued();
+        std::this_thread::yield();
+    }
+
+    for (std::thread& producer : producers)
+    {
+        producer.join();
+    }
+
+    dispatcher.dispatchQueued();
+
+    EXPECT_EQ(receiver.receivedCount, PRODUCERS_COUNT * POSTS_COUNT);
+    EXPECT_EQ(receiver.failuresCount, 0u);
+    EXPECT_EQ(createdCount, sinkCreators.size());
+}
+
+namespace {
+
+struct RoutedEvent
+{
+    EventKey keys[MAX_EVENT_ROUTING_KEYS];
+    size_t   keysCount;
+
+    size_t getRoutingKeys(EventKey* routingKeys) const
+    {
+        std::copy(keys, keys + keysCount, routingKeys);
+        return keysCount;
+    }
+};
+
+struct RoutedEventsCounter
+{
+    size_t receivedCount{0};
+
+    void onRouted(const RoutedEvent& /*event*/) { ++receivedCount; }
+};
+
+} // namespace
+
+TEST(EventDispatcherTests, KeyedHandlersReceiveOnlyTheirKeys)
+{
+    EventDispatcher         dispatcher;
+    EventSink<RoutedEvent>& sink = dispatcher.getSink<RoutedEvent>();
+
+    RoutedEventsCounter first;
+    RoutedEventsCounter second;
+    RoutedEventsCounter unrelated;
+    RoutedEventsCounter unkeyed;
+
+    ScopedConnection firstConnection(sink.addKeyedHandler<&RoutedEventsCounter::onRouted>(1, first));
+    ScopedConnection secondConnection(sink.addKeyedHandler<&RoutedEventsCounter::onRouted>(2, second));
+    ScopedConnection unrelatedConnection(sink.addKeyedHandler<&RoutedEventsCounter::onRouted>(3, unrelated));
+    ScopedConnection unkeyedConnection(sink.addHandler<&RoutedEventsCounter::onRouted>(unkeyed));
+    EXPECT_EQ(sink.getHandlersCount(), 4u);
+
+    dispatcher.fireEvent<RoutedEvent>(RoutedEvent{{1, 2}, 2});
+    EXPECT_EQ(first.receivedCount, 1u);
+    EXPECT_EQ(second.receivedCount, 1u);
+    EXPECT_EQ(unrelated.receivedCount, 0u);
+    EXPECT_EQ(unkeyed.receivedCount, 1u);
+
+    dispatcher.enqueueEvent<RoutedEvent>(RoutedEvent{{2}, 1});
+    dispatcher.enqueueEvent<RoutedEvent>(RoutedEvent{{4}, 1});
+    EXPECT_EQ(second.receivedCount, 1u);
+
+    dispatcher.dispatchQueued();
+    EXPECT_EQ(first.receivedCount, 1u);
+    EXPECT_EQ(second.receivedCount, 2u);
+    EXPECT_EQ(unrelated.receivedCount, 0u);
+    EXPECT_EQ(unkeyed.receivedCount, 3u);
+}
+
+TEST(EventDispatcherTests, RemovedKeyedHandlersAreReleased)
+{
+    EventDispatcher         dispatcher;
+    EventSink<RoutedEvent>& sink = dispatcher.getSink<RoutedEvent>();
+
+    RoutedEventsCounter connected;
+    RoutedEventsCounter removed;
+
+    Connection connection = sink.addKeyedHandler<&RoutedEventsCounter::onRouted>(1, connected);
+    sink.addKeyedHandler<&RoutedEventsCounter::onRouted>(2, removed);
+    EXPECT_TRUE(sink.hasHandlers());
+
+    connection.disconnect();
+    sink.removeKeyedHandler<&RoutedEventsCounter::onRouted>(2, removed);
+    EXPECT_EQ(sink.getHandlersCount(), 0u);
+
+    dispatcher.fireEvent<RoutedEvent>(RoutedEvent{{1, 2}, 2});
+    EXPECT_EQ(connected.receivedCount, 0u);
+    EXPECT_EQ(removed.receivedCount, 0u);
+
+    /* Empty lists are released after dispatch */
+    dispatcher.enqueueEvent<RoutedEvent>(RoutedEvent{{1}, 1});
+    dispatcher.dispatchQueued();
+    EXPECT_FALSE(sink.hasHandlers());
+}
+
+/* Released lists are reused for other keys, connections to their former handlers must not remove the new ones */
+TEST(EventDispatcherTests, StaleKeyedConnectionsAreIgnored)
+{
+    EventDispatcher         dispatcher;
+    EventSink<RoutedEvent>& sink = dispatcher.getSink<RoutedEvent>();
+
+    RoutedEventsCounter stale;
+    RoutedEventsCounter reused;
+
+    Connection staleConnection = sink.addKeyedHandler<&RoutedEventsCounter::onRouted>(1, stale);
+    sink.removeKeyedHandler<&RoutedEventsCounter::onRouted>(1, stale);
+    dispatcher.enqueueEvent<RoutedEvent>(RoutedEvent{{1}, 1});
+    dispatcher.dispatchQueued();
+    EXPECT_FALSE(sink.hasHandlers());
+
+    ScopedConnection reusedConnection(sink.addKeyedHandler<&RoutedEventsCounter::onRouted>(2, reused));
+    EXPECT_TRUE(staleConnection.isConnected());
+    staleConnection.disconnect();
+    EXPECT_EQ(sink.getHandlersCount(), 1u);
+
+    dispatcher.fireEvent<RoutedEvent>(RoutedEvent{{1, 2}, 2});
+    EXPECT_EQ(stale.receivedCount, 0u);
+    EXPECT_EQ(reused.receivedCount, 1u);
+}
@@ -0,0 +1,297 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file event_sink_tests.cpp
+ * @date 2026-10-17
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "events/event_sink.hpp"
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace gwars;
+
+namespace {
+
+struct SinkEvent
+{
+};
+
+using CallLog = std::vector<int>;
+
+struct Recorder
+{
+    CallLog* log;
+    int      id;
+
+    void onEvent(const SinkEvent& /*event*/) { log->push_back(id); }
+};
+
+/* Disconnects the targets on the first call */
+struct Disconnector
+{
+    CallLog*                 log;
+    int                      id;
+    std::vector<Connection>* targets;
+
+    void onEvent(const SinkEvent& /*event*/)
+    {
+        log->push_back(id);
+
+        for (Connection& target : *targets)
+        {
+            target.disconnect();
+        }
+    }
+};
+
+/* Subscribes the recorder on the first call */
+struct Subscriber
+{
+    CallLog*                       log;
+    int                            id;
+    EventSink<SinkEvent>*          sink;
+    Recorder*                      added;
+    std::vector<ScopedConnection>* connections;
+
+    void onEvent(const SinkEvent& /*event*/)
+    {
+        log->push_back(id);
+
+        if (connections->empty())
+        {
+            connections->emplace_back(sink->addHandler<&Recorder::onEvent>(*added));
+        }
+    }
+};
+
+/* Disconnects the target and fires the event again from within the first call */
+struct Refirer
+{
+    CallLog*              log;
+    int                   id;
+    EventSink<SinkEvent>* sink;
+    Connection*           target;
+    bool                  fired{false};
+
+    void onEvent(const SinkEvent& event)
+    {
+        log->push_back(id);
+
+        if (!fired)
+        {
+            fired = true;
+            target->disconnect();
+            sink->fireEvent(event);
+        }
+    }
+};
+
+} // namespace
+
+TEST(EventSinkTests, HandlersRemovedDuringDispatchAreSkipped)
+{
+    EventSink<SinkEvent>    sink;
+    CallLog                 log;
+    std::vector<Connection> targets;
+
+    Recorder     first{&log, 1};
+    Disconnector second{&log, 2, &targets};
+    Recorder     third{&log, 3};
+
+    ScopedConnection firstConnection(sink.addHandler<&Recorder::onEvent>(first));
+    ScopedConnection secondConnection(sink.addHandler<&Disconnector::onEvent>(second));
+    targets.push_back(sink.addHandler<&Recorder::onEvent>(third));
+
+    sink.fireEvent(SinkEvent{});
+    EXPECT_EQ(log, CallLog({1, 2}));
+    EXPECT_EQ(sink.getHandlersCount(), 2u);
+
+    sink.fireEvent(SinkEvent{});
+    EXPECT_EQ(log, CallLog({1, 2, 1, 2}));
+}
+
+TEST(EventSinkTests, HandlerRemovingItself)
+{
+    EventSink<SinkEvent>    sink;
+    CallLog                 log;
+    std::vector<Connection> targets;
+
+    Disconnector first{&log, 1, &targets};
+    Recorder     second{&log, 2};
+
+    targets.push_back(sink.addHandler<&Disconnector::onEvent>(first));
+    ScopedConnection secondConnection(sink.addHandler<&Recorder::onEvent>(second));
+
+    sink.fireEvent(SinkEvent{});
+    sink.fireEvent(SinkEvent{});
+    EXPECT_EQ(log, CallLog({1, 2, 2}));
+    EXPECT_EQ(sink.getHandlersCount(), 1u);
+}
+
+TEST(EventSinkTests, HandlersAddedDuringDispatchStartOnNextEvent)
+{
+    EventSink<SinkEvent>          sink;
+    CallLog                       log;
+    std::vector<ScopedConnection> added;
+
+    Recorder   recorder{&log, 2};
+    Subscriber subscriber{&log, 1, &sink, &recorder, &added};
+
+    ScopedConnection subscriberConnection(sink.addHandler<&Subscriber::onEvent>(subscriber));
+
+    sink.fireEvent(SinkEvent{});
+    EXPECT_EQ(log, CallLog({1}));
+    EXPECT_EQ(sink.getHandlersCount(), 2u);
+
+    sink.fireEvent(SinkEvent{});
+    EXPECT_EQ(log, CallLog({1, 1, 2}));
+}
+
+/* Most of the list becomes tombstones, compaction must keep the order of the remaining handlers */
+TEST(EventSinkTests, CompactionKeepsHandlersOrder)
+{
+    constexpr int RECORDERS_COUNT = 8;
+
+    EventSink<SinkEvent>          sink;
+    CallLog                       log;
+    std::vector<Connection>       targets;
+    std::vector<ScopedConnection> kept;
+
+    Disconnector          disconnector{&log, 0, &targets};
+    std::vector<Recorder> recorders;
+    for (int i = 1; i <= RECORDERS_COUNT; ++i)
+    {
+        recorders.push_back(Recorder{&log, i});
+    }
+
+    ScopedConnection disconnectorConnection(sink.addHandler<&Disconnector::onEvent>(disconnector));
+    for (int i = 0; i < RECORDERS_COUNT; ++i)
+    {
+        /* Odd recorders are removed along with the last one */
+        Connection connection = sink.addHandler<&Recorder::onEvent>(recorders[i]);
+        if (recorders[i].id % 2 == 1 || recorders[i].id == RECORDERS_COUNT)
+        {
+            targets.push_back(std::move(connection));
+        }
+        else
+        {
+            kept.emplace_back(std::move(connection));
+        }
+    }
+
+    ASSERT_EQ(targets.size(), 5u);
+
+    sink.fireEvent(SinkEvent{});
+    EXPECT_EQ(log, CallLog({0, 2, 4, 6}));
+
+    log.clear();
+    sink.fireEvent(SinkEvent{});
+    EXPECT_EQ(log, CallLog({0, 2, 4, 6}));
+
+    /* Connections stay valid after compaction */
+    kept[1].disconnect();
+    log.clear();
+    sink.fireEvent(SinkEvent{});
+    EXPECT_EQ(log, CallLog({0, 2, 6}));
+    EXPECT_EQ(sink.getHandlersCount(), 3u);
+}
+
+/* Tombstones left by a nested call are compacted only once the outer call is done */
+TEST(EventSinkTests, RemovalDuringNestedDispatch)
+{
+    EventSink<SinkEvent> sink;
+    CallLog              log;
+    Connection           target;
+
+    Refirer  refirer{&log, 1, &sink, &target};
+    Recorder second{&log, 2};
+    Recorder third{&log, 3};
+
+    ScopedConnection refirerConnection(sink.addHandler<&Refirer::onEvent>(refirer));
+    target = sink.addHandler<&Recorder::onEvent>(second);
+    ScopedConnection thirdConnection(sink.addHandler<&Recorder::onEvent>(third));
+
+    sink.fireEvent(SinkEvent{});
+    EXPECT_EQ(log, CallLog({1, 1, 3, 3}));
+    EXPECT_EQ(sink.getHandlersCount(), 2u);
+}
+
+TEST(EventSinkTests, ScopedConnections)
+{
+    EventSink<SinkEvent> sink;
+    CallLog              log;
+    Recorder             first{&log, 1};
+    Recorder             second{&log, 2};
+
+    {
+        ScopedConnection connection(sink.addHandler<&Recorder::onEvent>(first));
+        EXPECT_TRUE(connection.isConnected());
+        EXPECT_EQ(sink.getHandlersCount(), 1u);
+    }
+    EXPECT_EQ(sink.getHandlersCount(), 0u);
+
+    ScopedConnection connection(sink.addHandler<&Recorder::onEvent>(first));
+
+    /* Moving transfers the handler, assigning disconnects the previous one */
+    ScopedConnection moved(std::move(connection));
+    EXPECT_FALSE(connection.isConnected());
+    EXPECT_TRUE(moved.isConnected());
+
+    moved = ScopedConnection(sink.addHandler<&Recorder::onEvent>(second));
+    sink.fireEvent(SinkEvent{});
+    EXPECT_EQ(log, CallLog({2}));
+
+    /* Released connections outlive the scope */
+    Connection released;
+    {
+        ScopedConnection scoped(sink.addHandler<&Recorder::onEvent>(first));
+        released = scoped.release();
+    }
+    EXPECT_EQ(sink.getHandlersCount(), 2u);
+
+    released.disconnect();
+    EXPECT_FALSE(released.isConnected());
+    released.disconnect();
+    EXPECT_EQ(sink.getHandlersCount(), 1u);
+}
+
+/* Ids of removed handlers are reused, disconnecting through a stale id must not remove the new handler */
+TEST(EventSinkTests, StaleConnectionsAreIgnored)
+{
+    EventSink<SinkEvent> sink;
+    CallLog              log;
+    Recorder             first{&log, 1};
+    Recorder             second{&log, 2};
+
+    Connection stale = sink.addHandler<&Recorder::onEvent>(first);
+    sink.removeHandler<&Recorder::onEvent>(first);
+    EXPECT_TRUE(stale.isConnected());
+
+    ScopedConnection connection(sink.addHandler<&Recorder::onEvent>(second));
+    stale.disconnect();
+    EXPECT_EQ(sink.getHandlersCount(), 1u);
+
+    sink.fireEvent(SinkEvent{});
+    EXPECT_EQ(log, CallLog({2}));
+}
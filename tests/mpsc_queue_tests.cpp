@@ -0,0 +1,240 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file mpsc_queue_tests.cpp
+ * @date 2026-10-17
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "utils/mpsc_queue.hpp"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using namespace gwars;
+
+/* Values are tagged with the producer index in the upper half and the push number in the lower half */
+static uint64_t makeValue(uint32_t producer, uint32_t number)
+{
+    return (static_cast<uint64_t>(producer) << 32) | number;
+}
+
+static void runProducersStress(uint32_t producersCount, uint32_t pushesCount, size_t capacity, bool useConsumeAll)
+{
+    MpscQueue<uint64_t> queue(capacity);
+
+    std::vector<std::thread> producers;
+    for (uint32_t producer = 0; producer < producersCount; ++producer)
+    {
+        producers.emplace_back([&queue, producer, pushesCount]() {
+            for (uint32_t number = 0; number < pushesCount; ++number)
+            {
+                while (!queue.tryPush(makeValue(producer, number)))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::vector<uint32_t> nextNumbers(producersCount, 0);
+    size_t                consumedCount = 0;
+    size_t                failuresCount = 0;
+
+    auto consume = [&](uint64_t value) {
+        uint32_t producer = static_cast<uint32_t>(value >> 32);
+        uint32_t number   = static_cast<uint32_t>(value);
+
+        if (producer >= producersCount || number != nextNumbers[producer])
+        {
+            ++failuresCount;
+            return;
+        }
+
+        ++nextNumbers[producer];
+        ++consumedCount;
+    };
+
+    size_t totalCount = static_cast<size_t>(producersCount) * pushesCount;
+    while (consumedCount + failuresCount < totalCount)
+    {
+        bool consumed = false;
+        if (useConsumeAll)
+        {
+            consumed = queue.consumeAll(consume) > 0;
+        }
+        else
+        {
+            uint64_t value = 0;
+            if (queue.tryPop(value))
+            {
+                consume(value);
+                consumed = true;
+            }
+        }
+
+        if (!consumed)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    for (std::thread& thread : producers)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(failuresCount, 0u);
+    EXPECT_EQ(consumedCount, totalCount);
+
+    for (uint32_t producer = 0; producer < producersCount; ++producer)
+    {
+        EXPECT_EQ(nextNumbers[producer], pushesCount);
+    }
+
+    uint64_t value = 0;
+    EXPECT_FALSE(queue.tryPop(value));
+}
+
+TEST(MpscQueue, ProducersStressTryPop) { runProducersStress(8, 50000, 64, false); }
+
+TEST(MpscQueue, ProducersStressConsumeAll) { runProducersStress(8, 50000, 64, true); }
+
+TEST(MpscQueue, CapacityIsRoundedUp)
+{
+    MpscQueue<int> queue(5);
+    EXPECT_EQ(queue.getCapacity(), 8u);
+}
+
+TEST(MpscQueue, SingleValueCapacityDoesNotOverwrite)
+{
+    MpscQueue<int> queue(1);
+    EXPECT_EQ(queue.getCapacity(), 2u);
+
+    EXPECT_TRUE(queue.tryPush(1));
+    EXPECT_TRUE(queue.tryPush(2));
+    EXPECT_FALSE(queue.tryPush(3));
+
+    int value = 0;
+    EXPECT_TRUE(queue.tryPop(value));
+    EXPECT_EQ(value, 1);
+    EXPECT_TRUE(queue.tryPop(value));
+    EXPECT_EQ(value, 2);
+    EXPECT_FALSE(queue.tryPop(value));
+}
+
+TEST(MpscQueue, FullQueueRejectsPush)
+{
+    MpscQueue<int> queue(4);
+
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_TRUE(queue.tryPush(i));
+    }
+
+    EXPECT_FALSE(queue.tryPush(4));
+    EXPECT_FALSE(queue.tryPush(4));
+
+    int value = -1;
+    EXPECT_TRUE(queue.tryPop(value));
+    EXPECT_EQ(value, 0);
+
+    EXPECT_TRUE(queue.tryPush(4));
+    EXPECT_FALSE(queue.tryPush(5));
+
+    for (int expected = 1; expected <= 4; ++expected)
+    {
+        EXPECT_TRUE(queue.tryPop(value));
+        EXPECT_EQ(value, expected);
+    }
+
+    EXPECT_FALSE(queue.tryPop(value));
+}
+
+TEST(MpscQueue, FullQueueRejectsPushFromManyThreads)
+{
+    MpscQueue<int> queue(16);
+
+    std::vector<std::thread> producers;
+    std::vector<int>         pushedCounts(4, 0);
+    for (size_t producer = 0; producer < pushedCounts.size(); ++producer)
+    {
+        producers.emplace_back([&queue, &pushedCounts, producer]() {
+            for (int i = 0; i < 100; ++i)
+            {
+                pushedCounts[producer] += queue.tryPush(i);
+            }
+        });
+    }
+
+    for (std::thread& thread : producers)
+    {
+        thread.join();
+    }
+
+    int pushedCount = 0;
+    for (int count : pushedCounts)
+    {
+        pushedCount += count;
+    }
+
+    EXPECT_EQ(pushedCount, 16);
+    EXPECT_EQ(queue.consumeAll([](int) {}), 16u);
+}
+
+TEST(MpscQueue, ConsumeAllLeavesValuesPushedByConsumer)
+{
+    MpscQueue<int> queue(16);
+
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_TRUE(queue.tryPush(i));
+    }
+
+    std::vector<int> consumed;
+    size_t           consumedCount = queue.consumeAll([&](int value) {
+        consumed.push_back(value);
+        queue.tryPush(value + 10);
+    });
+
+    EXPECT_EQ(consumedCount, 4u);
+    EXPECT_EQ(consumed, (std::vector<int>{0, 1, 2, 3}));
+
+    consumed.clear();
+    EXPECT_EQ(queue.consumeAll([&](int value) { consumed.push_back(value); }), 4u);
+    EXPECT_EQ(consumed, (std::vector<int>{10, 11, 12, 13}));
+}
+
+TEST(MpscQueue, DestroysValuesLeftInQueue)
+{
+    std::shared_ptr<int> value = std::make_shared<int>(0);
+
+    {
+        MpscQueue<std::shared_ptr<int>> queue(8);
+        queue.tryPush(value);
+        queue.tryPush(value);
+        EXPECT_EQ(value.use_count(), 3);
+    }
+
+    EXPECT_EQ(value.use_count(), 1);
+}
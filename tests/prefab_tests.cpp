@@ -0,0 +1,168 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file prefab_tests.cpp
+ * @date 2026-10-17
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ecs/command_buffer.hpp"
+#include "ecs/prefab.hpp"
+#include <gtest/gtest.h>
+
+using namespace gwars;
+
+namespace {
+
+struct Position
+{
+    float x{0};
+    float y{0};
+};
+
+struct Velocity
+{
+    float x{0};
+    float y{0};
+};
+
+} // namespace
+
+TEST(PrefabTests, InstancesCopyPrototypes)
+{
+    EntityManager manager;
+
+    Prefab prefab;
+    prefab.add<Position>(Position{1, 2}).add<Velocity>(Velocity{3, 4});
+
+    std::vector<Entity> instances;
+    instantiate(manager, prefab, 3, [&](Entity entity, size_t index) {
+        entity.getComponent<Position>().x += static_cast<float>(index);
+        instances.push_back(entity);
+    });
+
+    ASSERT_EQ(instances.size(), 3u);
+    for (size_t i = 0; i < instances.size(); ++i)
+    {
+        EXPECT_EQ(instances[i].getComponent<Position>().x, 1.0f + static_cast<float>(i));
+        EXPECT_EQ(instances[i].getComponent<Position>().y, 2.0f);
+        EXPECT_EQ(instances[i].getComponent<Velocity>().x, 3.0f);
+    }
+}
+
+/* Batches spawned by an initializer are pushed on top of the outer batch's ids */
+TEST(PrefabTests, InitializersCanInstantiate)
+{
+    EntityManager manager;
+
+    Prefab outer;
+    outer.add<Position>();
+
+    Prefab inner;
+    inner.add<Velocity>();
+
+    std::vector<EntityId> outerIds;
+    size_t                innerCount = 0;
+    instantiate(manager, outer, 4, [&](Entity entity, size_t) {
+        outerIds.push_back(entity.getId());
+        instantiate(manager, inner, 100, [&](Entity, size_t) { ++innerCount; });
+    });
+
+    EXPECT_EQ(innerCount, 400u);
+    ASSERT_EQ(outerIds.size(), 4u);
+    for (size_t i = 0; i < outerIds.size(); ++i)
+    {
+        EXPECT_TRUE(manager.hasComponent<Position>(outerIds[i]));
+        EXPECT_FALSE(manager.hasComponent<Velocity>(outerIds[i]));
+
+        for (size_t j = 0; j < i; ++j)
+        {
+            EXPECT_NE(outerIds[i], outerIds[j]);
+        }
+    }
+}
+
+/* Exact reserves reallocated every pool and the slot arrays on each spawn past the capacity */
+TEST(PrefabTests, SpawningOneByOneGrowsGeometrically)
+{
+    constexpr size_t SPAWNS_COUNT = 4096;
+
+    EntityManager manager;
+
+    Prefab prefab;
+    prefab.add<Position>().add<Velocity>();
+
+    for (size_t i = 0; i < SPAWNS_COUNT; ++i)
+    {
+        instantiate(manager, prefab, 1);
+    }
+
+    EXPECT_EQ(manager.getPool<Position>().size(), SPAWNS_COUNT);
+    EXPECT_LT(manager.getAllocationsCount(), 200u);
+}
+
+/* Spawns and destroys the same numbers of entities every cycle, as the game does with projectiles */
+TEST(PrefabTests, SteadyStateSpawningDoesNotAllocate)
+{
+    constexpr size_t WARM_UP_CYCLES = 4;
+    constexpr size_t CYCLES         = 100;
+
+    EntityManager manager;
+    CommandBuffer commands;
+
+    Prefab prefab;
+    prefab.add<Position>().add<Velocity>(Velocity{1, 1});
+
+    auto runCycle = [&]() {
+        for (size_t i = 0; i < 16; ++i)
+        {
+            float x = static_cast<float>(i);
+            commands.instantiate(prefab, 1, [x](Entity entity, size_t) { entity.getComponent<Position>().x = x; });
+        }
+
+        commands.instantiate(prefab, 32, [](Entity, size_t) {});
+        commands.flush(manager);
+
+        ComponentPool<Position>& pool = manager.getPool<Position>();
+        for (size_t i = 0; i < pool.size(); ++i)
+        {
+            commands.destroyEntity(pool.getEntities()[i]);
+        }
+
+        commands.flush(manager);
+    };
+
+    for (size_t cycle = 0; cycle < WARM_UP_CYCLES; ++cycle)
+    {
+        runCycle();
+    }
+
+    const size_t allocationsCount = manager.getAllocationsCount();
+
+    for (size_t cycle = 0; cycle < CYCLES; ++cycle)
+    {
+        runCycle();
+    }
+
+    EXPECT_EQ(manager.getAllocationsCount() - allocationsCount, 0u);
+    EXPECT_EQ(manager.getPool<Position>().size(), 0u);
+}
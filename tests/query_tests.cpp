@@ -0,0 +1,157 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file query_tests.cpp
+ * @date 2026-10-17
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ecs/query.hpp"
+#include <gtest/gtest.h>
+
+using namespace gwars;
+
+namespace {
+
+struct Position
+{
+    float x{0};
+};
+
+struct Velocity
+{
+    float x{0};
+};
+
+struct Frozen
+{
+};
+
+} // namespace
+
+using MovingQuery = Query<Exclude<Frozen>, Position, const Velocity>;
+
+TEST(QueryTests, CollectsExistingMembers)
+{
+    EntityManager manager;
+
+    EntityId moving = manager.createEntity();
+    manager.createComponent<Position>(moving);
+    manager.createComponent<Velocity>(moving);
+
+    EntityId frozen = manager.createEntity();
+    manager.createComponent<Position>(frozen);
+    manager.createComponent<Velocity>(frozen);
+    manager.createComponent<Frozen>(frozen);
+
+    EntityId still = manager.createEntity();
+    manager.createComponent<Position>(still);
+
+    MovingQuery query{manager};
+
+    ASSERT_EQ(query.size(), 1u);
+    EXPECT_TRUE(query.contains(moving));
+    EXPECT_FALSE(query.contains(frozen));
+    EXPECT_FALSE(query.contains(still));
+}
+
+TEST(QueryTests, MembershipFollowsStructuralChanges)
+{
+    EntityManager manager;
+    MovingQuery   query{manager};
+
+    EntityId entity = manager.createEntity();
+    manager.createComponent<Position>(entity);
+    EXPECT_FALSE(query.contains(entity));
+
+    manager.createComponent<Velocity>(entity);
+    EXPECT_TRUE(query.contains(entity));
+
+    manager.createComponent<Frozen>(entity);
+    EXPECT_FALSE(query.contains(entity));
+
+    manager.removeComponent<Frozen>(entity);
+    EXPECT_TRUE(query.contains(entity));
+
+    manager.removeComponent<Position>(entity);
+    EXPECT_FALSE(query.contains(entity));
+
+    manager.createComponent<Position>(entity);
+    EXPECT_TRUE(query.contains(entity));
+
+    manager.removeEntity(entity);
+    EXPECT_FALSE(query.contains(entity));
+    EXPECT_EQ(query.size(), 0u);
+}
+
+TEST(QueryTests, BatchDestructionRemovesMembers)
+{
+    EntityManager         manager;
+    MovingQuery           query{manager};
+    std::vector<EntityId> entities;
+
+    for (int32_t i = 0; i < 10; ++i)
+    {
+        EntityId entity = manager.createEntity();
+        manager.createComponent<Position>(entity, Position{static_cast<float>(i)});
+        manager.createComponent<Velocity>(entity);
+        entities.push_back(entity);
+    }
+
+    manager.destroyEntities(entities.data(), 5);
+
+    ASSERT_EQ(query.size(), 5u);
+    for (size_t i = 0; i < entities.size(); ++i)
+    {
+        EXPECT_EQ(query.contains(entities[i]), i >= 5);
+    }
+
+    /* Swap-and-pop must keep the dense array consistent with the positions */
+    for (auto [entity, position, velocity] : query)
+    {
+        EXPECT_GE(position.x, 5);
+        EXPECT_TRUE(query.contains(entity.getId()));
+    }
+}
+
+TEST(QueryTests, DestroyedQueryDisconnects)
+{
+    EntityManager manager;
+
+    const size_t constructHandlersCount = manager.onConstruct<Position>().getHandlersCount();
+    const size_t removeHandlersCount    = manager.onRemove<Frozen>().getHandlersCount();
+
+    {
+        MovingQuery query{manager};
+        EXPECT_EQ(manager.onConstruct<Position>().getHandlersCount(), constructHandlersCount + 1);
+        EXPECT_EQ(manager.onRemove<Frozen>().getHandlersCount(), removeHandlersCount + 1);
+    }
+
+    EXPECT_EQ(manager.onConstruct<Position>().getHandlersCount(), constructHandlersCount);
+    EXPECT_EQ(manager.onRemove<Frozen>().getHandlersCount(), removeHandlersCount);
+
+    /* Events fired after the query is gone must not reach it */
+    EntityId entity = manager.createEntity();
+    manager.createComponent<Position>(entity);
+    manager.createComponent<Velocity>(entity);
+    manager.removeEntity(entity);
+}
@@ -0,0 +1,141 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file rigid_body_storage_tests.cpp
+ * @date 2026-10-17
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "scene/rigid_body_storage.hpp"
+#include <gtest/gtest.h>
+
+using namespace gwars;
+
+constexpr float PHYSICS_DT = 1.0f / 60.0f;
+
+static void addBodies(RigidBodyStorage& storage, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        EntityId id = makeEntityId(i + 1, 1);
+        storage.addBody(id, Vec2f(static_cast<float>(i), -static_cast<float>(i)), Vec2f(1, -1), 1.0f + (i % 3));
+        storage.setForce(id, Vec2f(0.5f, static_cast<float>(i % 7)));
+    }
+}
+
+TEST(RigidBodyStorageTests, RemovalMovesLastBody)
+{
+    RigidBodyStorage storage;
+    addBodies(storage, 10);
+
+    storage.removeBody(makeEntityId(3, 1));
+    storage.removeBody(makeEntityId(10, 1));
+
+    ASSERT_EQ(storage.size(), 8u);
+    EXPECT_FALSE(storage.contains(makeEntityId(3, 1)));
+    EXPECT_FALSE(storage.contains(makeEntityId(10, 1)));
+    EXPECT_FALSE(storage.contains(makeEntityId(4, 2)));
+
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        EntityId id = makeEntityId(i + 1, 1);
+        if (i == 2 || i == 9)
+        {
+            continue;
+        }
+
+        ASSERT_TRUE(storage.contains(id));
+        EXPECT_EQ(storage.getTranslation(id).x, static_cast<float>(i));
+        EXPECT_EQ(storage.getMass(id), 1.0f + (i % 3));
+        EXPECT_EQ(storage.getForce(id).y, static_cast<float>(i % 7));
+    }
+
+    /* Re-added bodies don't inherit the removed ones' forces */
+    storage.addBody(makeEntityId(3, 2), Vec2f(0, 0));
+    EXPECT_EQ(storage.getForce(makeEntityId(3, 2)).y, 0);
+    EXPECT_EQ(storage.getMass(makeEntityId(3, 2)), 1);
+}
+
+TEST(RigidBodyStorageTests, ColumnsAreAlignedAndPadded)
+{
+    RigidBodyStorage storage;
+
+    for (uint32_t count : {1u, 9u, 100u, 1000u})
+    {
+        addBodies(storage, count);
+
+        EXPECT_EQ(storage.capacity() % RigidBodyStorage::BLOCK_SIZE, 0u);
+        for (size_t column = 0; column < RigidBodyStorage::COLUMNS_COUNT; ++column)
+        {
+            const float* values = storage.getColumn(static_cast<RigidBodyStorage::Column>(column));
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(values) % RigidBodyStorage::COLUMN_ALIGNMENT, 0u);
+        }
+
+        storage.clear();
+    }
+}
+
+/* Counts around the block size check that the padding never leaks into real bodies */
+TEST(RigidBodyStorageTests, SimdKernelMatchesPerBodyStep)
+{
+    for (uint32_t count : {1u, 7u, 8u, 9u, 1000u, 1003u})
+    {
+        RigidBodyStorage simd;
+        RigidBodyStorage scalar;
+        addBodies(simd, count);
+        addBodies(scalar, count);
+
+        if (count > 1)
+        {
+            simd.removeBody(makeEntityId(1, 1));
+            scalar.removeBody(makeEntityId(1, 1));
+        }
+
+        for (int32_t step = 0; step < 10; ++step)
+        {
+            simd.integrate(PHYSICS_DT);
+            scalar.integrateScalar(PHYSICS_DT);
+        }
+
+        for (uint32_t i = (count > 1) ? 1 : 0; i < count; ++i)
+        {
+            EntityId id = makeEntityId(i + 1, 1);
+
+            /* Same operations as in PhysicsSystem */
+            Vec2f velocity(1, -1);
+            Vec2f translation(static_cast<float>(i), -static_cast<float>(i));
+            for (int32_t step = 0; step < 10; ++step)
+            {
+                velocity += Vec2f(0.5f, static_cast<float>(i % 7)) / (1.0f + (i % 3)) * PHYSICS_DT;
+                translation += velocity * PHYSICS_DT;
+            }
+
+            EXPECT_FLOAT_EQ(simd.getVelocity(id).x, velocity.x);
+            EXPECT_FLOAT_EQ(simd.getVelocity(id).y, velocity.y);
+            EXPECT_FLOAT_EQ(simd.getTranslation(id).x, translation.x);
+            EXPECT_FLOAT_EQ(simd.getTranslation(id).y, translation.y);
+
+            EXPECT_FLOAT_EQ(scalar.getTranslation(id).x, simd.getTranslation(id).x);
+            EXPECT_FLOAT_EQ(scalar.getTranslation(id).y, simd.getTranslation(id).y);
+        }
+    }
+}
@@ -0,0 +1,225 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file snapshot_tests.cpp
+ * @date 2026-10-17
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ecs/snapshot.hpp"
+#include "scene/components.hpp"
+#include <gtest/gtest.h>
+#include <string>
+
+using namespace gwars;
+
+namespace {
+
+struct Position
+{
+    float x{0};
+    float y{0};
+};
+
+struct Name
+{
+    std::string value;
+};
+
+} // namespace
+
+static void saveWorld(EntityManager& manager, BinaryWriter& writer)
+{
+    manager.saveEntities(writer);
+    savePool<Position>(manager, writer);
+    savePool<Name>(manager, writer, [](BinaryWriter& writer, const Name& name) {
+        writer.writeValue<uint64_t>(name.value.size());
+        writer.write(name.value.data(), name.value.size());
+    });
+}
+
+static bool loadWorld(EntityManager& manager, BinaryReader& reader)
+{
+    auto loadName = [](BinaryReader& reader, Name& name) {
+        uint64_t    size  = reader.readValue<uint64_t>();
+        const void* chars = reader.readArray(size, 1, 1);
+        if (chars != nullptr)
+        {
+            name.value.assign(static_cast<const char*>(chars), size);
+        }
+
+        return chars != nullptr;
+    };
+
+    return manager.loadEntities(reader) && loadPool<Position>(manager, reader)
+           && loadPool<Name>(manager, reader, loadName);
+}
+
+/* Entity slots followed by a pool of Position, which lists the given entities */
+static std::vector<uint8_t> makePositionsSnapshot(EntityManager& manager, const std::vector<EntityId>& entities)
+{
+    BinaryWriter writer;
+    manager.saveEntities(writer);
+
+    std::vector<Position> positions(entities.size());
+    writer.writeValue<uint64_t>(entities.size());
+    writer.writeBlock(entities.data(), entities.size() * sizeof(EntityId), alignof(EntityId));
+    writer.writeBlock(positions.data(), positions.size() * sizeof(Position), alignof(Position));
+
+    return writer.getData();
+}
+
+TEST(SnapshotTests, RoundTripRestoresEntitiesAndComponents)
+{
+    EntityManager source;
+    EntityId      first  = source.createEntity();
+    EntityId      second = source.createEntity();
+    EntityId      third  = source.createEntity();
+
+    source.createComponent<Position>(first, Position{1, 2});
+    source.createComponent<Position>(third, Position{5, 6});
+    source.createComponent<Name>(third, Name{"third"});
+    source.removeEntity(second);
+
+    BinaryWriter writer;
+    saveWorld(source, writer);
+
+    EntityManager loaded;
+    BinaryReader  reader(writer.getData().data(), writer.getData().size());
+    ASSERT_TRUE(loadWorld(loaded, reader));
+
+    EXPECT_TRUE(loaded.isAlive(first));
+    EXPECT_FALSE(loaded.isAlive(second));
+    EXPECT_TRUE(loaded.isAlive(third));
+
+    EXPECT_EQ(loaded.getComponent<Position>(first).x, 1.0f);
+    EXPECT_EQ(loaded.getComponent<Position>(third).y, 6.0f);
+    EXPECT_FALSE(loaded.hasComponent<Name>(first));
+    EXPECT_EQ(loaded.getComponent<Name>(third).value, "third");
+
+    /* The free list is restored too, so both managers reuse the same slot */
+    EXPECT_EQ(loaded.createEntity(), source.createEntity());
+}
+
+TEST(SnapshotTests, TruncatedSnapshotsAreRejected)
+{
+    EntityManager source;
+    for (int i = 0; i < 4; ++i)
+    {
+        EntityId id = source.createEntity();
+        source.createComponent<Position>(id, Position{static_cast<float>(i), 0});
+        source.createComponent<Name>(id, Name{"entity"});
+    }
+
+    BinaryWriter writer;
+    saveWorld(source, writer);
+
+    const std::vector<uint8_t>& data = writer.getData();
+    for (size_t size = 0; size < data.size(); ++size)
+    {
+        EntityManager loaded;
+        BinaryReader  reader(data.data(), size);
+        EXPECT_FALSE(loadWorld(loaded, reader)) << "size " << size;
+    }
+}
+
+TEST(SnapshotTests, RepeatedEntityIsRejected)
+{
+    EntityManager source;
+    EntityId      first  = source.createEntity();
+    EntityId      second = source.createEntity();
+
+    std::vector<uint8_t> data = makePositionsSnapshot(source, {first, second, first});
+
+    EntityManager loaded;
+    BinaryReader  reader(data.data(), data.size());
+    ASSERT_TRUE(loaded.loadEntities(reader));
+    EXPECT_FALSE(loadPool<Position>(loaded, reader));
+    EXPECT_EQ(loaded.getPool<Position>().size(), 0u);
+}
+
+TEST(SnapshotTests, DeadEntityIsRejected)
+{
+    EntityManager source;
+    EntityId      first  = source.createEntity();
+    EntityId      second = source.createEntity();
+    source.removeEntity(second);
+
+    std::vector<uint8_t> data = makePositionsSnapshot(source, {first, second});
+
+    EntityManager loaded;
+    BinaryReader  reader(data.data(), data.size());
+    ASSERT_TRUE(loaded.loadEntities(reader));
+    EXPECT_FALSE(loadPool<Position>(loaded, reader));
+    EXPECT_EQ(loaded.getPool<Position>().size(), 0u);
+}
+
+TEST(SnapshotTests, RepeatedEntityIsRejectedByLoadHook)
+{
+    EntityManager source;
+    EntityId      id = source.createEntity();
+
+    BinaryWriter writer;
+    source.saveEntities(writer);
+
+    std::vector<EntityId> entities{id, id};
+    writer.writeValue<uint64_t>(entities.size());
+    writer.writeBlock(entities.data(), entities.size() * sizeof(EntityId), alignof(EntityId));
+
+    EntityManager loaded;
+    BinaryReader  reader(writer.getData().data(), writer.getData().size());
+    ASSERT_TRUE(loaded.loadEntities(reader));
+    EXPECT_FALSE(loadPool<Name>(loaded, reader, [](BinaryReader&, Name&) { return true; }));
+    EXPECT_EQ(loaded.getPool<Name>().size(), 1u);
+}
+
+TEST(SnapshotTests, HierarchyValidation)
+{
+    EntityManager manager;
+    EntityId      root  = manager.createEntity();
+    EntityId      child = manager.createEntity();
+    EntityId      other = manager.createEntity();
+
+    setParent(manager, child, root);
+    setParent(manager, other, root);
+    EXPECT_TRUE(isValidHierarchy(manager));
+
+    /* Sibling list looping back to its start */
+    manager.getComponent<HierarchyComponent>(child).nextSibling = other;
+    manager.getComponent<HierarchyComponent>(other).nextSibling = child;
+    EXPECT_FALSE(isValidHierarchy(manager));
+
+    /* Child, which its parent doesn't list */
+    manager.getComponent<HierarchyComponent>(root).firstChild   = child;
+    manager.getComponent<HierarchyComponent>(child).nextSibling = INVALID_ENTITY_ID;
+    manager.getComponent<HierarchyComponent>(other).nextSibling = INVALID_ENTITY_ID;
+    EXPECT_FALSE(isValidHierarchy(manager));
+
+    /* Parent cycle */
+    manager.getComponent<HierarchyComponent>(other).parent = INVALID_ENTITY_ID;
+    manager.getComponent<HierarchyComponent>(root).parent  = child;
+    EXPECT_FALSE(isValidHierarchy(manager));
+
+    /* Link to an entity without HierarchyComponent */
+    manager.getComponent<HierarchyComponent>(root).parent = manager.createEntity();
+    EXPECT_FALSE(isValidHierarchy(manager));
+}
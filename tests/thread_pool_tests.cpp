@@ -0,0 +1,112 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file thread_pool_tests.cpp
+ * @date 2026-10-17
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "utils/thread_index.hpp"
+#include "utils/thread_pool.hpp"
+#include <atomic>
+#include <gtest/gtest.h>
+
+using namespace gwars;
+
+static uint32_t getIndexOnNewThread()
+{
+    uint32_t    index = MAX_THREADS;
+    std::thread thread([&index]() { index = getThreadIndex(); });
+    thread.join();
+
+    return index;
+}
+
+TEST(ThreadPoolTests, ThreadIndicesAreReusedAfterThreadsExit)
+{
+    getThreadIndex();
+
+    /* Used to run out of indices after MAX_THREADS threads over the whole process lifetime */
+    for (uint32_t i = 0; i < 4 * MAX_THREADS; ++i)
+    {
+        EXPECT_LT(getIndexOnNewThread(), MAX_THREADS);
+    }
+}
+
+struct IndexRecorder
+{
+    std::atomic<uint64_t> seenIndices{0};
+    std::atomic<uint32_t> repeatedCount{0};
+    std::atomic<uint32_t> finishedCount{0};
+};
+
+static void recordThreadIndex(void* data)
+{
+    IndexRecorder* recorder = static_cast<IndexRecorder*>(data);
+
+    uint64_t bit = uint64_t{1} << getThreadIndex();
+    if ((recorder->seenIndices.fetch_or(bit) & bit) != 0)
+    {
+        ++recorder->repeatedCount;
+    }
+
+    /* Keep the worker busy, so that every job lands on a different one */
+    ++recorder->finishedCount;
+    while (recorder->finishedCount.load() < 4)
+    {
+        std::this_thread::yield();
+    }
+}
+
+TEST(ThreadPoolTests, WorkersHaveDistinctIndices)
+{
+    uint64_t mainBit = uint64_t{1} << getThreadIndex();
+
+    ThreadPool    pool(4);
+    IndexRecorder recorder;
+    for (int32_t i = 0; i < 4; ++i)
+    {
+        pool.submit(&recordThreadIndex, &recorder);
+    }
+
+    while (recorder.finishedCount.load() < 4)
+    {
+        std::this_thread::yield();
+    }
+
+    EXPECT_EQ(recorder.repeatedCount.load(), 0u);
+    EXPECT_EQ(recorder.seenIndices.load() & mainBit, 0u);
+}
+
+TEST(ThreadPoolTests, PoolIsLimitedByFreeIndices)
+{
+    getThreadIndex();
+
+    {
+        ThreadPool pool(2 * MAX_THREADS);
+        EXPECT_EQ(pool.getThreadsCount(), MAX_THREADS - 1);
+        EXPECT_EQ(reserveThreadIndex(), MAX_THREADS);
+    }
+
+    /* Indices of the joined workers are free again */
+    EXPECT_LT(getIndexOnNewThread(), MAX_THREADS);
+}
@@ -0,0 +1,154 @@
+/**
+ * @author Nikita Mochalov (github.com/tralf-strues)
+ * @file transform_system_tests.cpp
+ * @date 2026-10-17
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2022 Nikita Mochalov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "scene/scene.hpp"
+#include "scene/systems.hpp"
+#include <gtest/gtest.h>
+
+using namespace gwars;
+
+static EntityId createNode(EntityManager& manager, const Vec2f& translation, EntityId parent = INVALID_ENTITY_ID)
+{
+    EntityId id = manager.createEntity();
+    manager.createComponent<TransformComponent>(id, translation);
+    manager.createComponent<WorldTransformComponent>(id);
+
+    if (parent != INVALID_ENTITY_ID)
+    {
+        setParent(manager, id, parent);
+    }
+
+    return id;
+}
+
+static Vec2f getWorldTranslation(EntityManager& manager, EntityId id)
+{
+    return manager.getComponent<const WorldTransformComponent>(id).getTranslation();
+}
+
+TEST(TransformSystemTests, ChildrenAreRelativeToParents)
+{
+    EventDispatcher dispatcher;
+    Scene           scene(dispatcher);
+    EntityManager&  manager = scene.getEntityManager();
+    TransformSystem system(scene);
+
+    EntityId root       = createNode(manager, Vec2f(10, 0));
+    EntityId child      = createNode(manager, Vec2f(1, 2), root);
+    EntityId grandchild = createNode(manager, Vec2f(0, 3), child);
+
+    system.onUpdate(0);
+
+    EXPECT_EQ(getWorldTranslation(manager, root), Vec2f(10, 0));
+    EXPECT_EQ(getWorldTranslation(manager, child), Vec2f(11, 2));
+    EXPECT_EQ(getWorldTranslation(manager, grandchild), Vec2f(11, 5));
+}
+
+TEST(TransformSystemTests, MovingParentUpdatesOnlyItsSubtree)
+{
+    EventDispatcher dispatcher;
+    Scene           scene(dispatcher);
+    EntityManager&  manager = scene.getEntityManager();
+    TransformSystem system(scene);
+
+    EntityId moved      = createNode(manager, Vec2f(0, 0));
+    EntityId movedChild = createNode(manager, Vec2f(1, 0), moved);
+    EntityId still      = createNode(manager, Vec2f(0, 10));
+    EntityId stillChild = createNode(manager, Vec2f(1, 0), still);
+
+    system.onUpdate(0);
+
+    const ComponentPool<WorldTransformComponent>& worldTransforms = manager.getPool<WorldTransformComponent>();
+    const uint64_t                                version         = worldTransforms.getVersion();
+
+    manager.getComponent<TransformComponent>(moved).translation = Vec2f(5, 5);
+    system.onUpdate(0);
+
+    EXPECT_EQ(getWorldTranslation(manager, movedChild), Vec2f(6, 5));
+    EXPECT_TRUE(worldTransforms.isChangedSince(moved, version));
+    EXPECT_TRUE(worldTransforms.isChangedSince(movedChild, version));
+
+    EXPECT_FALSE(worldTransforms.isChangedSince(still, version));
+    EXPECT_FALSE(worldTransforms.isChangedSince(stillChild, version));
+
+    /* Nothing has changed, so nothing is recomputed */
+    const uint64_t cleanVersion = worldTransforms.getVersion();
+    system.onUpdate(0);
+    EXPECT_EQ(worldTransforms.getVersion(), cleanVersion);
+}
+
+TEST(TransformSystemTests, ParentAndChildMovedInSameFrame)
+{
+    EventDispatcher dispatcher;
+    Scene           scene(dispatcher);
+    EntityManager&  manager = scene.getEntityManager();
+    TransformSystem system(scene);
+
+    EntityId root  = createNode(manager, Vec2f(0, 0));
+    EntityId child = createNode(manager, Vec2f(1, 0), root);
+    system.onUpdate(0);
+
+    /* The child is changed first, so it would be visited before its parent */
+    manager.getComponent<TransformComponent>(child).translation = Vec2f(2, 0);
+    manager.getComponent<TransformComponent>(root).translation  = Vec2f(0, 7);
+
+    const ComponentPool<WorldTransformComponent>& worldTransforms = manager.getPool<WorldTransformComponent>();
+    const uint64_t                                version         = worldTransforms.getVersion();
+
+    system.onUpdate(0);
+
+    EXPECT_EQ(getWorldTranslation(manager, child), Vec2f(2, 7));
+
+    /* Each of the two world transforms is written once */
+    EXPECT_EQ(worldTransforms.getVersion(), version + 2);
+}
+
+TEST(TransformSystemTests, ReparentingMovesSubtree)
+{
+    EventDispatcher dispatcher;
+    Scene           scene(dispatcher);
+    EntityManager&  manager = scene.getEntityManager();
+    TransformSystem system(scene);
+
+    EntityId first      = createNode(manager, Vec2f(10, 0));
+    EntityId second     = createNode(manager, Vec2f(20, 0));
+    EntityId child      = createNode(manager, Vec2f(1, 0), first);
+    EntityId grandchild = createNode(manager, Vec2f(1, 0), child);
+    system.onUpdate(0);
+
+    setParent(manager, child, second);
+    system.onUpdate(0);
+
+    EXPECT_EQ(getWorldTranslation(manager, child), Vec2f(21, 0));
+    EXPECT_EQ(getWorldTranslation(manager, grandchild), Vec2f(22, 0));
+
+    setParent(manager, child, INVALID_ENTITY_ID);
+    system.onUpdate(0);
+
+    EXPECT_EQ(getWorldTranslation(manager, child), Vec2f(1, 0));
+    EXPECT_EQ(getWorldTranslation(manager, grandchild), Vec2f(2, 0));
+}